@@ -2,25 +2,35 @@
 // Created by Oscar Tesniere on 11/02/2026.
 //
 
+#if defined(ARDUINO)
+
 #include "Controller.h"
+#include "ControllerUi.h"
 
 Controller::Controller(const char* ssid, const char* password)
-    : _ssid(ssid), _password(password) {}
+    : _ssid(ssid), _password(password) {
+#if CONTROLLER_PROFILER
+    _profiler.setBudgetUs(DEFAULT_LOOP_BUDGET_US);
+#endif
+    buildInputCurve(_inputCurveType, _deadband, _inputCurve);
+    buildPwmTable(_motorMinPWM, _pwmTable);
+}
 
 bool Controller::registerButton(const char* label, void (*cb)()) {
-    if (_buttonCount >= MAX_BUTTONS) return false;
-    _buttons[_buttonCount].label = label;
-    _buttons[_buttonCount].cb = cb;
-    _buttonCount++;
-    return true;
+    return _widgets->addButton(label, cb);
 }
 
 void Controller::clearButtons() {
-    _buttonCount = 0;
+    _widgets->clearButtons();
 }
 
-void Controller::registerCallback(void (*callback)(const String&)) {
-    _onMessage = callback;
+void Controller::attachWidgets(WidgetRegistry& widgets) {
+    _widgets = &widgets;
+}
+
+void Controller::registerEventCallback(WidgetEventCallback callback, void* ctx) {
+    _onEvent = callback;
+    _onEventCtx = ctx;
 }
 
 void Controller::registerDriveCallback(void (*callback)(int8_t left, int8_t right)) {
@@ -31,13 +41,28 @@ void Controller::setFailsafeTimeoutMs(uint16_t ms) {
     _failsafeTimeoutMs = ms;
 }
 
+void Controller::setHttpRequestTimeoutMs(uint16_t ms) {
+    _httpRequestTimeoutMs = ms;
+}
+
+void Controller::setHttpKeepAlive(uint16_t idleTimeoutMs, uint16_t maxRequests) {
+    _httpIdleTimeoutMs = idleTimeoutMs;
+    _httpMaxRequests = maxRequests;
+}
+
 void Controller::configureL298N(
     uint8_t ena, uint8_t in1, uint8_t in2,
     uint8_t enb, uint8_t in3, uint8_t in4
 ) {
-    _l298nEnabled = true;
-    _ena = ena; _in1 = in1; _in2 = in2;
-    _enb = enb; _in3 = in3; _in4 = in4;
+    _l298n.setChannel(0, { ena, in1, in2, {}, {} });
+    _l298n.setChannel(1, { enb, in3, in4, {}, {} });
+    attachMotorDriver(_l298n);
+}
+
+void Controller::attachMotorOutput(void* ctx, MotorBeginFn begin, MotorApplyFn apply) {
+    _motorCtx = ctx;
+    _motorBegin = begin;
+    _motorApply = apply;
 }
 
 void Controller::setMotorDebugPrintIntervalMs(uint16_t ms) {
@@ -49,12 +74,8 @@ bool Controller::beginAP(bool debug) {
     if (_ledEnabled) setLedStateHold(LED_BOOTING, 1500);
     _debug = debug;
 
-    if (_l298nEnabled) {
-        pinMode(_in1, OUTPUT); pinMode(_in2, OUTPUT);
-        pinMode(_in3, OUTPUT); pinMode(_in4, OUTPUT);
-        pinMode(_ena, OUTPUT); pinMode(_enb, OUTPUT);
-        motorInitSafeStop();
-    }
+    // Motor pins to outputs, every motor braked
+    if (_motorBegin) _motorBegin(_motorCtx);
 
     if (wifiSSIDExistsNearby()) { // _debug &&
         Serial.print("[WiFi] NOTE: an AP with SSID already exists nearby: ");
@@ -90,6 +111,7 @@ bool Controller::beginAP(bool debug) {
 
     _lastDriveMs = millis();
     _failsafeStopped = false;
+    publishDriveTarget();
 
     Serial.println("AP mode started");
     printWiFiStatus();
@@ -97,68 +119,194 @@ bool Controller::beginAP(bool debug) {
 }
 
 void Controller::update() {
-    // Handle ONE incoming client per loop; keep loop fast
-    WiFiClient client = _server.available();
-    if (client) {
-        client.setTimeout(30);
-        handleClient(client);
-        delay(1);
-        client.stop();
+    // The gap between calls is the sketch's loop period
+    const uint32_t period = profileLoopStart(micros());
+    if (period > _loopMaxGapUs) _loopMaxGapUs = period;
+    _loopCount++;
+
+    // Network: accept new connections, then let every slot consume whatever
+    // bytes are already buffered. Nothing in here waits on a socket.
+    acceptClients();
+    for (uint8_t i = 0; i < MAX_CLIENTS; i++) {
+        if (!_clients[i].active) continue;
+        if (_clients[i].webSocket) serviceWebSocket(_clients[i]);
+        else if (_clients[i].eventStream) serviceEventStream(_clients[i]);
+        else serviceClient(_clients[i]);
     }
+    profileMark(PROFILE_NETWORK);
+
+    if (_udpEnabled) serviceUdp();
+    profileMark(PROFILE_UDP);
 
-    // Failsafe check
+    // Failsafe, smoothing and motor output; with the control timer running
+    // the interrupt has already done this and only the results are handled here
     const unsigned long now = millis();
-    if (_failsafeTimeoutMs > 0 && (now - _lastDriveMs) > _failsafeTimeoutMs) {
-        _failsafeStopped = true;
-        setLedStateHold(LED_FAILSAFE, 1200);
+    if (_controlTimerHz == 0) {
+        const unsigned long nowUs = micros();
+        controlStep(nowUs - _lastSmoothUs);
+        _lastSmoothUs = nowUs;
     }
+    if (_failsafeStopped) setLedStateHold(LED_FAILSAFE, 1200);
+    notifyDriveChanges();
+    profileMark(PROFILE_CONTROL);
+
+    _widgets->dispatch(_onEvent, _onEventCtx);   // user callbacks: after the motors, outside any handler
+    profileMark(PROFILE_EVENTS);
 
-    // Apply smoothing and notify motors (also handles failsafe)
-    applySmoothingAndNotify();
     updateStatusLED();   // update the LED status (if enabled)
+    profileMark(PROFILE_LED);
+
+    if (_telemetryIntervalMs > 0) serviceTelemetry(now);
+    profileMark(PROFILE_TELEMETRY);
 }
 
-void Controller::applySmoothingAndNotify() {
-    auto applyDeadband = [&](int8_t v) -> int8_t {
-        if (abs((int)v) < (int)_deadband) return 0;
-        return v;
-    };
+void Controller::controlStep(uint32_t dtUs) {
+    // Called from update() or from the control timer interrupt: no Serial,
+    // no user callbacks, and the targets only through the published snapshot
+    const volatile DriveTarget& target = _targets[_targetIndex];
+    const uint32_t stampMs = target.stampMs;
+
+    const bool failsafe = _failsafeTimeoutMs > 0 && (millis() - stampMs) > _failsafeTimeoutMs;
+    _failsafeStopped = failsafe;
+
+    // Deadband and response curve were applied to the sticks before mixing
+    bool changed = false;
+    for (uint8_t i = 0; i < _motorCount; i++) {
+        const int8_t goal = failsafe ? 0 : target.motor[i];
+
+        // Ramp by elapsed time, not per call, so the loop rate does not matter
+        const int8_t v = _slew[i].step(goal, dtUs);
+        if (v != _out[i]) {
+            _out[i] = v;
+            changed = true;
+        }
+    }
+    if (changed) _outputsChanged = true;
+
+    int8_t drive[DRIVE_MAX_MOTORS];
+    for (uint8_t i = 0; i < _motorCount; i++) drive[i] = _out[i];
+
+    if (_encodersEnabled) {
+        // Closed loop: the smoothed left/right outputs are wheel speed setpoints
+        for (uint8_t i = 0; i < 2; i++) {
+            drive[i] = _wheelPid[i].step(_out[i], _encoders[i].decoder.count(), dtUs);
+            if (drive[i] != _drive[i]) {
+                _drive[i] = drive[i];
+                changed = true;
+            }
+        }
+    }
 
-    int8_t targetL = _failsafeStopped ? 0 : applyDeadband(_cmdLeft);
-    int8_t targetR = _failsafeStopped ? 0 : applyDeadband(_cmdRight);
+    // Motor driver (if attached)
+    if (changed && _motorApply) {
+        _motorApply(_motorCtx, drive, _pwmTable, _motorCount);
+    }
+}
 
-    auto stepToward = [&](int8_t cur, int8_t tgt) -> int8_t {
-        int d = (int)tgt - (int)cur;
+void Controller::notifyDriveChanges() {
+    if (!_outputsChanged) return;
 
-        // Use a bigger step when we are braking toward zero
-        int step = (tgt == 0) ? (int)_slewPerUpdateStop : (int)_slewPerUpdate;
+    // Copy the outputs as one so a timer tick cannot split them
+    int8_t out[DRIVE_MAX_MOTORS];
+    noInterrupts();
+    _outputsChanged = false;
+    for (uint8_t i = 0; i < _motorCount; i++) out[i] = _out[i];
+    interrupts();
 
-        if (d > step) d = step;
-        if (d < -step) d = -step;
-        return (int8_t)((int)cur + d);
-    };
+    debugMotors(out[0], out[1]);
 
-    int8_t newL = stepToward(_outLeft, targetL);
-    int8_t newR = stepToward(_outRight, targetR);
+    // Optional external callbacks
+    if (_onDrive) {
+        _onDrive(out[0], out[1]);
+    }
+    if (_onMotors) {
+        _onMotors(out, _motorCount);
+    }
+}
 
-    if (newL == _outLeft && newR == _outRight) return;
+void Controller::publishDriveTarget() {
+    // Fill the buffer the control step is not reading, then flip: the
+    // interrupt always sees a complete set of targets and their stamp
+    const uint8_t next = _targetIndex ^ 1;
+    for (uint8_t i = 0; i < DRIVE_MAX_MOTORS; i++) _targets[next].motor[i] = _cmd[i];
+    _targets[next].stampMs = _lastDriveMs;
+    _targetIndex = next;
+}
 
-    _outLeft = newL;
-    _outRight = newR;
+bool Controller::beginControlTimer(uint16_t hz) {
+    if (hz == 0 || _controlTimerHz != 0) return false;
 
-    // Internal motor driver (if enabled)
-    if (_l298nEnabled) {
-        motorApply(_outLeft, _outRight);
+    // Same facility as the Servo library: any free GPT/AGT channel
+    uint8_t type = 0;
+    const int8_t channel = FspTimer::get_available_timer(type);
+    if (channel < 0) {
+        Serial.println("[CTRL] no free timer for the control tick");
+        return false;
     }
 
-    // Optional external callback
-    if (_onDrive) {
-        _onDrive(_outLeft, _outRight);
+    _controlTickUs = 1000000UL / hz;
+    if (!_controlTimer.begin(TIMER_MODE_PERIODIC, type, (uint8_t)channel, (float)hz, 50.0f,
+                             controlTimerIsr, this)) {
+        Serial.println("[CTRL] control timer setup failed");
+        return false;
+    }
+    _controlTimer.set_period_buffer(false);
+    _controlTimer.setup_overflow_irq(10);
+    _controlTimer.open();
+
+    // update() stops stepping before the first tick can run
+    _controlTimerHz = hz;
+    _controlTimer.start();
+
+    if (_debug) {
+        Serial.print("[CTRL] control tick at ");
+        Serial.print(hz);
+        Serial.println(" Hz");
     }
+    return true;
+}
+
+void Controller::controlTimerIsr(timer_callback_args_t* args) {
+    Controller* self = static_cast<Controller*>(const_cast<void*>(args->p_context));
+    self->controlStep(self->_controlTickUs);
+}
+
+void Controller::setAccelRate(uint16_t unitsPerSec) {
+    _accelRate = unitsPerSec;
+    for (uint8_t i = 0; i < DRIVE_MAX_MOTORS; i++) _slew[i].setRates(_accelRate, _decelRate, _brakeRate);
 }
 
-int8_t Controller::speedLeft() const { return _outLeft; }
-int8_t Controller::speedRight() const { return _outRight; }
+void Controller::setDecelRate(uint16_t unitsPerSec) {
+    _decelRate = unitsPerSec;
+    for (uint8_t i = 0; i < DRIVE_MAX_MOTORS; i++) _slew[i].setRates(_accelRate, _decelRate, _brakeRate);
+}
+
+void Controller::setBrakeRate(uint16_t unitsPerSec) {
+    _brakeRate = unitsPerSec;
+    for (uint8_t i = 0; i < DRIVE_MAX_MOTORS; i++) _slew[i].setRates(_accelRate, _decelRate, _brakeRate);
+}
+
+void Controller::setJerkLimit(uint16_t unitsPerSec2) {
+    for (uint8_t i = 0; i < DRIVE_MAX_MOTORS; i++) _slew[i].setJerk(unitsPerSec2);
+}
+
+int8_t Controller::speedLeft() const { return _out[0]; }
+int8_t Controller::speedRight() const { return _out[1]; }
+
+int8_t Controller::speed(uint8_t motor) const {
+    return motor < _motorCount ? _out[motor] : 0;
+}
+
+void Controller::setDriveMode(DriveMode mode) {
+    _driveMode = mode;
+    _motorCount = driveMotorCount(mode);
+    for (uint8_t i = 0; i < DRIVE_MAX_MOTORS; i++) _cmd[i] = 0;
+    publishDriveTarget();
+}
+
+void Controller::registerMotorCallback(void (*callback)(const int8_t* speeds, uint8_t count)) {
+    _onMotors = callback;
+}
 
 bool Controller::wifiSSIDExistsNearby() {
     int n = WiFi.scanNetworks();
@@ -224,109 +372,856 @@ void Controller::printWiFiStatus() const {
 }
 void Controller::setMotorMinPWM(uint8_t pwm) {
     _motorMinPWM = pwm;
+    buildPwmTable(_motorMinPWM, _pwmTable);
+}
+
+void Controller::setMotorPwmFrequency(uint32_t hz) {
+    _l298n.policy().pwmHz = hz;
 }
 
-String Controller::readRequestLine(WiFiClient& client) {
-    unsigned long start = millis();
-    while (client.connected() && !client.available()) {
-        if (millis() - start > 30) return "";
-        delay(1);
+// -------------------- Wheel encoders --------------------
+
+bool Controller::configureEncoders(uint8_t leftA, uint8_t leftB,
+                                   uint8_t rightA, uint8_t rightB,
+                                   uint32_t countsPerSec) {
+    if (_encodersEnabled) return false;
+
+    const uint8_t pins[2][2] = { { leftA, leftB }, { rightA, rightB } };
+    for (uint8_t i = 0; i < 2; i++) {
+        EncoderInput& enc = _encoders[i];
+        enc.pinA = pins[i][0];
+        enc.pinB = pins[i][1];
+        pinMode(enc.pinA, INPUT_PULLUP);
+        pinMode(enc.pinB, INPUT_PULLUP);
+        enc.decoder.begin(readEncoderPins(enc));
+
+        _wheelPid[i].setMaxSpeed(countsPerSec);
+        _wheelPid[i].reset();
+
+        // Both edges of both channels: 4 counts per line
+        attachInterruptParam(enc.pinA, encoderIsr, CHANGE, &enc);
+        attachInterruptParam(enc.pinB, encoderIsr, CHANGE, &enc);
     }
-    String line = client.readStringUntil('\n');
-    line.trim();
-    return line;
+
+    _drive[0] = _drive[1] = 0;
+    _encodersEnabled = true;
+    return true;
 }
 
-void Controller::sendHttpOk(WiFiClient& client, const char* contentType, const String& body) {
-    client.println("HTTP/1.1 200 OK");
-    client.print("Content-Type: ");
-    client.println(contentType);
-    client.println("Connection: close");
-    client.print("Content-Length: ");
-    client.println(body.length());
-    client.println();
-    client.print(body);
+void Controller::setSpeedPid(float kp, float ki, float kd) {
+    // Converted once here; the control step only uses the Q10 integers
+    const float one = (float)WheelSpeedController::GAIN_ONE;
+    for (uint8_t i = 0; i < 2; i++) {
+        _wheelPid[i].setGains((int32_t)(kp * one + 0.5f), (int32_t)(ki * one + 0.5f),
+                              (int32_t)(kd * one + 0.5f));
+    }
 }
 
-void Controller::sendHttpNotFound(WiFiClient& client) {
-    const String body = "Not Found";
-    client.println("HTTP/1.1 404 Not Found");
-    client.println("Content-Type: text/plain; charset=utf-8");
-    client.println("Connection: close");
-    client.print("Content-Length: ");
-    client.println(body.length());
-    client.println();
-    client.print(body);
+int32_t Controller::encoderCount(uint8_t wheel) const {
+    return wheel < 2 ? _encoders[wheel].decoder.count() : 0;
 }
 
-int Controller::clampInt(int v, int lo, int hi) {
-    if (v < lo) return lo;
-    if (v > hi) return hi;
-    return v;
+int16_t Controller::measuredSpeed(uint8_t wheel) const {
+    return wheel < 2 ? _wheelPid[wheel].measuredPercent() : 0;
+}
+
+uint8_t Controller::readEncoderPins(const EncoderInput& enc) {
+    return (uint8_t)((digitalRead(enc.pinA) == HIGH ? 2 : 0) | (digitalRead(enc.pinB) == HIGH ? 1 : 0));
+}
+
+void Controller::encoderIsr(void* ctx) {
+    EncoderInput* enc = static_cast<EncoderInput*>(ctx);
+    enc->decoder.update(readEncoderPins(*enc));
+}
+
+void Controller::setInputCurve(ResponseCurve curve) {
+    _inputCurveType = curve;
+    buildInputCurve(_inputCurveType, _deadband, _inputCurve);
+}
+
+void Controller::setDeadband(uint8_t deadband) {
+    _deadband = deadband > 50 ? 50 : deadband;
+    buildInputCurve(_inputCurveType, _deadband, _inputCurve);
+}
+
+// -------------------- HTTP connection table --------------------
+
+void Controller::acceptClients() {
+    ClientSlot* slot = nullptr;
+    ClientSlot* idle = nullptr;     // oldest persistent connection waiting for a request
+    ClientSlot* stream = nullptr;   // oldest /events stream
+
+    const unsigned long now = millis();
+    for (uint8_t i = 0; i < MAX_CLIENTS; i++) {
+        ClientSlot& s = _clients[i];
+        if (!s.active) { slot = &s; break; }
+        if (s.eventStream) {
+            if (!stream || (now - s.lastRxMs) > (now - stream->lastRxMs)) stream = &s;
+        } else if (!s.webSocket && s.requests > 0 && !s.parser.started()) {
+            if (!idle || (now - s.lastRxMs) > (now - idle->lastRxMs)) idle = &s;
+        }
+    }
+
+    // Table full of busy connections: leave new ones in the modem backlog
+    if (!slot && !idle && !stream) return;
+
+    WiFiClient client = _server.accept();
+    if (!client) return;
+
+    // A waiting request beats an idle keep-alive connection, and then a
+    // telemetry stream (EventSource reconnects on its own)
+    if (!slot) {
+        slot = idle ? idle : stream;
+        closeClient(*slot);
+    }
+
+    slot->client = client;
+    slot->parser.reset();
+    slot->active = true;
+    slot->lastRxMs = now;
+    slot->requests = 0;
+    slot->acceptedUs = micros();
+}
+
+void Controller::serviceClient(ClientSlot& slot) {
+    uint8_t budget = HTTP_RX_BUDGET;
+
+    for (;;) {
+        // Consume buffered bytes, stopping at the end of the current request
+        while (budget > 0 && !slot.parser.done() && slot.client.available() > 0) {
+            int c = slot.client.read();
+            if (c < 0) break;
+            budget--;
+            slot.lastRxMs = millis();
+            if (!slot.parser.started()) slot.requestStartUs = micros();
+            slot.parser.feed((char)c);
+        }
+
+        if (slot.parser.state() == HttpRequestParser::ERROR) {
+            // Request line did not fit in the parser buffer
+            closeClient(slot);
+            return;
+        }
+        if (slot.parser.state() != HttpRequestParser::COMPLETE) break;
+
+        slot.requests++;
+        const HttpRequest& req = slot.parser.request();
+        const uint8_t route = metricRoute(req);
+        const unsigned long dispatchUs = micros();
+        _txWriteUs = 0;
+
+        if (isWebSocketRoute(req)) {
+            const bool upgraded = handleWebSocketUpgrade(slot);
+            recordRequestMetrics(slot, route, dispatchUs);
+            if (!upgraded) closeClient(slot);
+            return;
+        }
+        if (isEventStreamRoute(req) && _telemetryIntervalMs > 0) {
+            const bool started = handleEventStreamStart(slot);
+            recordRequestMetrics(slot, route, dispatchUs);
+            if (!started) closeClient(slot);
+            return;
+        }
+
+        _keepAliveResponse = _httpMaxRequests > 0
+                          && slot.requests < _httpMaxRequests
+                          && slot.parser.keepAliveRequested()
+                          && isPersistentRoute(req);
+        _keepAliveRemaining = _keepAliveResponse ? (uint16_t)(_httpMaxRequests - slot.requests) : 0;
+
+        dispatchRequest(slot.client, req);
+        recordRequestMetrics(slot, route, dispatchUs);
+
+        if (!_keepAliveResponse) {
+            closeClient(slot);
+            return;
+        }
+
+        // Pipelined requests may already be buffered behind this one
+        slot.parser.reset();
+        slot.lastRxMs = millis();
+    }
+
+    // Slow client mid-request, or persistent connection gone quiet
+    const uint16_t limit = slot.parser.started() ? _httpRequestTimeoutMs : _httpIdleTimeoutMs;
+    if (millis() - slot.lastRxMs > limit) {
+        closeClient(slot);
+    }
 }
 
-bool Controller::extractQueryInt(const String& requestLine, const char* key, int& outValue) {
-    int q = requestLine.indexOf('?');
-    if (q < 0) return false;
+void Controller::closeClient(ClientSlot& slot) {
+    slot.client.stop();
+    slot.parser.reset();
+    slot.active = false;
+    slot.requests = 0;
+    slot.webSocket = false;
+    slot.wsTelemetry = false;
+    slot.eventStream = false;
+}
 
-    int end = requestLine.indexOf(' ', q);
-    if (end < 0) return false;
+bool Controller::isPersistentRoute(const HttpRequest& req) {
+    // Only the high-rate command endpoints keep their connection open
+    return req.isGet("/drive") || req.isGet("/sld") || req.isGet("/btn");
+}
 
-    String query = requestLine.substring(q + 1, end);
+size_t Controller::writeToClient(void* ctx, const uint8_t* data, size_t len) {
+    Controller* self = static_cast<Controller*>(ctx);
+    const unsigned long t0 = micros();
+    const size_t n = self->_txClient->write(data, len);
+    self->_txWriteUs += micros() - t0;
+    return n;
+}
 
-    String k = String(key) + "=";
-    int pos = query.indexOf(k);
-    if (pos < 0) return false;
+size_t Controller::writeToPrint(void* ctx, const uint8_t* data, size_t len) {
+    return static_cast<Print*>(ctx)->write(data, len);
+}
 
-    int valStart = pos + k.length();
-    int amp = query.indexOf('&', valStart);
-    String valStr = (amp >= 0) ? query.substring(valStart, amp) : query.substring(valStart);
+ResponseWriter Controller::openWriter(WiFiClient& client) {
+    // Responses are produced one at a time, so every slot shares _txBuf
+    _txClient = &client;
+    return ResponseWriter(_txBuf, sizeof(_txBuf), writeToClient, this);
+}
 
-    valStr.replace("+", " ");
-    outValue = valStr.toInt();
+ResponseWriter Controller::beginResponse(WiFiClient& client, uint16_t code, const char* reason) {
+    ResponseWriter w = openWriter(client);
+    w.status(code, reason);
+    return w;
+}
+
+ResponseWriter Controller::beginStreamedResponse(WiFiClient& client, const HttpRequest& req,
+                                                 const char* contentType, const char* etag) {
+    // Length is unknown until the body is generated: chunked for HTTP/1.1,
+    // end-of-connection for HTTP/1.0 (these routes are never kept alive)
+    const bool chunked = req.httpMinor >= 1;
+
+    ResponseWriter w = beginResponse(client, 200, "OK");
+    w.header("Content-Type", contentType);
+    if (etag) {
+        w.header("ETag", etag);
+        w.header("Cache-Control", "no-cache");
+        w.header("Vary", "Accept-Encoding");
+    } else {
+        w.header("Cache-Control", "no-store");
+    }
+    if (!chunked) _keepAliveResponse = false;
+    printConnectionHeaders(w);
+    if (chunked) w.header("Transfer-Encoding", "chunked");
+    w.endHeaders();
+    if (chunked) w.beginChunked();
+    return w;
+}
+
+void Controller::printConnectionHeaders(ResponseWriter& w) {
+    if (!_keepAliveResponse) {
+        w.header("Connection", "close");
+        return;
+    }
+    w.header("Connection", "keep-alive");
+    w.print("Keep-Alive: timeout=");
+    w.print((long)(_httpIdleTimeoutMs / 1000));
+    w.print(", max=");
+    w.print((long)_keepAliveRemaining);
+    w.print("\r\n");
+}
+
+// -------------------- Telemetry stream (/events) --------------------
+
+void Controller::setTelemetryIntervalMs(uint16_t intervalMs) {
+    _telemetryIntervalMs = intervalMs;
+    if (intervalMs > 0) return;
+
+    // Disabled: end the open streams
+    for (uint8_t i = 0; i < MAX_CLIENTS; i++) {
+        if (_clients[i].active && _clients[i].eventStream) closeClient(_clients[i]);
+    }
+}
+
+bool Controller::isEventStreamRoute(const HttpRequest& req) {
+    return req.isGet("/events");
+}
+
+bool Controller::handleEventStreamStart(ClientSlot& slot) {
+    uint8_t streams = 0;
+    for (uint8_t i = 0; i < MAX_CLIENTS; i++) {
+        if (_clients[i].active && _clients[i].eventStream) streams++;
+    }
+
+    _keepAliveResponse = false;
+    if (streams >= MAX_EVENT_STREAMS) {
+        static const char body[] = "Too many event streams";
+        ResponseWriter w = beginResponse(slot.client, 503, "Service Unavailable");
+        w.header("Content-Type", "text/plain; charset=utf-8");
+        printConnectionHeaders(w);
+        w.header("Content-Length", (unsigned long)(sizeof(body) - 1));
+        w.endHeaders();
+        w.print(body);
+        w.flush();
+        return false;
+    }
+
+    // No length: the body is the stream, until either side closes
+    ResponseWriter w = beginResponse(slot.client, 200, "OK");
+    w.header("Content-Type", "text/event-stream");
+    w.header("Cache-Control", "no-store");
+    printConnectionHeaders(w);
+    w.endHeaders();
+    w.print("retry: 1000\n\n");   // EventSource reconnect delay
+    w.flush();
+
+    slot.eventStream = true;
     return true;
 }
 
-void Controller::handleClient(WiFiClient& client) {
-    String requestLine = readRequestLine(client);
-    if (requestLine.length() == 0) return;
+void Controller::serviceEventStream(ClientSlot& slot) {
+    // Clients never send on an event stream; drain anything that shows up
+    uint8_t budget = HTTP_RX_BUDGET;
+    while (budget > 0 && slot.client.available() > 0) {
+        if (slot.client.read() < 0) break;
+        budget--;
+    }
 
-    // Drain headers
-    while (client.connected()) {
-        String h = client.readStringUntil('\n');
-        if (h == "\r" || h.length() == 0) break;
+    if (!slot.client.connected()) closeClient(slot);
+}
+
+void Controller::serviceTelemetry(unsigned long now) {
+    if (now - _telemetryLastMs < _telemetryIntervalMs) return;
+
+    // Close the loop-stats window, even with nobody listening
+    const unsigned long elapsed = now - _telemetryLastMs;
+    _loopHz = (uint16_t)((_loopCount * 1000UL) / (elapsed ? elapsed : 1));
+    _loopMaxUs = _loopMaxGapUs;
+    _loopCount = 0;
+    _loopMaxGapUs = 0;
+    _telemetryLastMs = now;
+
+    for (uint8_t i = 0; i < MAX_CLIENTS; i++) {
+        ClientSlot& s = _clients[i];
+        if (!s.active) continue;
+        if (s.eventStream) sendTelemetryEvent(s);
+        else if (s.webSocket && s.wsTelemetry) sendWebSocketTelemetry(s);
+    }
+}
+
+void Controller::sendTelemetryEvent(ClientSlot& slot) {
+    ResponseWriter w = openWriter(slot.client);
+    w.print("data: ");
+    writeTelemetryJson(w);
+    w.print("\n\n");
+    w.flush();
+}
+
+void Controller::writeTelemetryJson(ResponseWriter& w) {
+    // {"l":0,"r":0,"tl":0,"tr":0,"fs":0,"sld":[..],"hz":0,"maxUs":0,"ovr":0}
+    w.print("{\"l\":");
+    w.print((int)_out[0]);
+    w.print(",\"r\":");
+    w.print((int)_out[1]);
+    w.print(",\"tl\":");
+    w.print((int)_cmd[0]);
+    w.print(",\"tr\":");
+    w.print((int)_cmd[1]);
+    w.print(",\"fs\":");
+    w.print(_failsafeStopped ? 1 : 0);
+    w.print(",\"sld\":[");
+    for (uint8_t i = 0; i < _widgets->sliderCount(); i++) {
+        if (i) w.print(',');
+        w.print(_widgets->slider(i).value);
+    }
+    w.print("],\"hz\":");
+    w.print((long)_loopHz);
+    w.print(",\"maxUs\":");
+    w.print((long)_loopMaxUs);
+    w.print(",\"ovr\":");
+    w.print((long)loopOverruns());
+    w.print('}');
+}
+
+size_t Controller::countBytes(void* ctx, const uint8_t* data, size_t len) {
+    (void)ctx;
+    (void)data;
+    return len;
+}
+
+// -------------------- Request metrics (/metrics) --------------------
+
+#if CONTROLLER_METRICS
+
+static const char* const kMetricRouteNames[] = {
+    "root", "ui_json", "drive", "btn", "sld", "ws", "events", "other"
+};
+static const char* const kMetricPhaseNames[] = {
+    "accept", "parse", "handler", "write"
+};
+
+uint8_t Controller::metricRoute(const HttpRequest& req) {
+    if (req.isGet("/drive")) return ROUTE_DRIVE;
+    if (req.isGet("/sld")) return ROUTE_SLD;
+    if (req.isGet("/btn")) return ROUTE_BTN;
+    if (req.isGet("/")) return ROUTE_ROOT;
+    if (req.isGet("/ui.json")) return ROUTE_UI_JSON;
+    if (isWebSocketRoute(req)) return ROUTE_WS;
+    if (isEventStreamRoute(req)) return ROUTE_EVENTS;
+    return ROUTE_OTHER;
+}
+
+void Controller::recordRequestMetrics(const ClientSlot& slot, uint8_t route, unsigned long dispatchUs) {
+    const uint32_t total = micros() - dispatchUs;
+    LatencyHistogram* h = _latency[route];
+
+    // Accept only applies to the first request on a connection
+    if (slot.requests == 1) h[PHASE_ACCEPT].record(slot.requestStartUs - slot.acceptedUs);
+    h[PHASE_PARSE].record(dispatchUs - slot.requestStartUs);
+    h[PHASE_HANDLER].record(total > _txWriteUs ? total - _txWriteUs : 0);
+    h[PHASE_WRITE].record(_txWriteUs);
+}
+
+void Controller::handleMetrics(WiFiClient& client, const HttpRequest& req) {
+    ResponseWriter w = beginStreamedResponse(client, req, "text/plain; version=0.0.4", nullptr);
+    writeMetrics(w);
+    w.finish();
+}
+
+void Controller::printMetrics(Print& out) {
+    ResponseWriter w(_txBuf, sizeof(_txBuf), writeToPrint, &out);
+    writeMetrics(w);
+    w.flush();
+}
+
+void Controller::resetMetrics() {
+    for (uint8_t r = 0; r < ROUTE_COUNT; r++) {
+        for (uint8_t p = 0; p < PHASE_COUNT; p++) _latency[r][p].reset();
     }
+}
+
+void Controller::writeMetrics(ResponseWriter& w) const {
+    static const char name[] = "controller_request_phase_seconds";
+    w.print("# HELP controller_request_phase_seconds Request latency by route and phase.\n");
+    w.print("# TYPE controller_request_phase_seconds histogram\n");
+
+    // Routes that never saw traffic are left out to keep the page small
+    for (uint8_t r = 0; r < ROUTE_COUNT; r++) {
+        for (uint8_t p = 0; p < PHASE_COUNT; p++) {
+            const LatencyHistogram& h = _latency[r][p];
+            if (h.count() == 0) continue;
+
+            char labels[40];
+            char* o = labels;
+            for (const char* s = "route=\""; *s; s++) *o++ = *s;
+            for (const char* s = kMetricRouteNames[r]; *s; s++) *o++ = *s;
+            for (const char* s = "\",phase=\""; *s; s++) *o++ = *s;
+            for (const char* s = kMetricPhaseNames[p]; *s; s++) *o++ = *s;
+            *o++ = '"';
+            *o = '\0';
+
+            writePrometheusHistogram(w, name, labels, h);
+        }
+    }
+}
+
+#else
+
+void Controller::printMetrics(Print& out) {
+    out.print("# request metrics disabled (CONTROLLER_METRICS=0)\n");
+}
+
+void Controller::resetMetrics() {
+}
+
+#endif // CONTROLLER_METRICS
+
+// -------------------- Loop profiler (/profile) --------------------
+
+#if CONTROLLER_PROFILER
+
+static const char* const kProfileSectionNames[] = {
+    "net", "udp", "control", "events", "led", "telemetry"
+};
+
+void Controller::setLoopBudgetUs(uint32_t budgetUs) {
+    _profiler.setBudgetUs(budgetUs);
+}
+
+void Controller::resetLoopProfile() {
+    _profiler.reset();
+}
+
+void Controller::printLoopProfile(Print& out) {
+    ResponseWriter w(_txBuf, sizeof(_txBuf), writeToPrint, &out);
+    _profiler.writeSummary(w, kProfileSectionNames);
+    w.flush();
+}
+
+void Controller::handleProfile(WiFiClient& client, const HttpRequest& req) {
+    // GET /profile[?reset=1]
+    ResponseWriter w = beginStreamedResponse(client, req, "text/plain; charset=utf-8", nullptr);
+    _profiler.writeSummary(w, kProfileSectionNames);
+    w.finish();
 
-    if (requestLine.startsWith("GET / ") || requestLine.startsWith("GET /?")) {
-        handleRoot(client);
+    int reset = 0;
+    if (req.paramInt("reset", reset) && reset) _profiler.reset();
+}
+
+#else
+
+void Controller::setLoopBudgetUs(uint32_t budgetUs) {
+    (void)budgetUs;
+}
+
+void Controller::resetLoopProfile() {
+}
+
+void Controller::printLoopProfile(Print& out) {
+    out.print("loop profiler disabled (CONTROLLER_PROFILER=0)\n");
+}
+
+#endif // CONTROLLER_PROFILER
+
+// -------------------- WebSocket control channel --------------------
+
+bool Controller::isWebSocketRoute(const HttpRequest& req) {
+    return req.isGet("/ws");
+}
+
+bool Controller::handleWebSocketUpgrade(ClientSlot& slot) {
+    WiFiClient& client = slot.client;
+
+    if (!slot.parser.webSocketUpgradeRequested()) {
+        static const char body[] = "Expected WebSocket upgrade";
+        ResponseWriter w = beginResponse(client, 400, "Bad Request");
+        w.header("Content-Type", "text/plain; charset=utf-8");
+        w.header("Connection", "close");
+        w.header("Content-Length", (unsigned long)(sizeof(body) - 1));
+        w.endHeaders();
+        w.print(body);
+        w.flush();
+        return false;
+    }
+
+    char accept[WS_ACCEPT_KEY_LEN + 1];
+    webSocketAcceptKey(slot.parser.webSocketKey(), accept);
+
+    ResponseWriter w = beginResponse(client, 101, "Switching Protocols");
+    w.header("Upgrade", "websocket");
+    w.header("Connection", "Upgrade");
+    w.header("Sec-WebSocket-Accept", accept);
+    w.endHeaders();
+    w.flush();
+
+    const unsigned long now = millis();
+    slot.webSocket = true;
+    slot.wsParser.reset();
+    slot.lastRxMs = now;
+    slot.lastTxMs = now;
+    slot.lastStateMs = now;
+    slot.lastPingMs = now;
+    slot.wsTelemetry = false;
+
+    setLedStateHold(LED_CLIENT_CONNECTED, 2000);
+
+    // Let the page show the current outputs right away
+    sendWebSocketState(slot, 0, WS_STATUS_OK);
+    return true;
+}
+
+void Controller::serviceWebSocket(ClientSlot& slot) {
+    uint8_t budget = HTTP_RX_BUDGET;
+    while (budget > 0 && slot.client.available() > 0) {
+        int c = slot.client.read();
+        if (c < 0) break;
+        budget--;
+        slot.lastRxMs = millis();
+
+        WebSocketFrameParser::Result r = slot.wsParser.feed((uint8_t)c);
+        if (r == WebSocketFrameParser::ERROR) {
+            // 1002 = protocol error
+            const uint8_t code[2] = { 0x03, 0xEA };
+            sendWebSocketFrame(slot, WS_OP_CLOSE, code, sizeof(code));
+            closeClient(slot);
+            return;
+        }
+        if (r != WebSocketFrameParser::FRAME) continue;
+
+        const uint8_t* payload = slot.wsParser.payload();
+        const uint8_t len = slot.wsParser.payloadLength();
+
+        switch (slot.wsParser.opcode()) {
+            case WS_OP_BINARY:
+                handleWebSocketMessage(slot, payload, len);
+                break;
+            case WS_OP_PING:
+                sendWebSocketFrame(slot, WS_OP_PONG, payload, len);
+                break;
+            case WS_OP_CLOSE:
+                // Echo the close frame, then drop the connection
+                sendWebSocketFrame(slot, WS_OP_CLOSE, payload, len >= 2 ? 2 : 0);
+                closeClient(slot);
+                return;
+            default:
+                // Text frames and pongs only count as activity
+                break;
+        }
+    }
+
+    // Peer gone without a close frame: free the slot now, not after the idle timeout
+    if (!slot.client.connected()) {
+        closeClient(slot);
+        return;
+    }
+
+    const unsigned long now = millis();
+    if (now - slot.lastRxMs > WS_IDLE_TIMEOUT_MS) {
+        closeClient(slot);
+        return;
+    }
+
+    // Push output changes (ramping, failsafe) without waiting for a command
+    const uint8_t flags = _failsafeStopped ? 1 : 0;
+    const bool changed = _out[0] != slot.sentLeft || _out[1] != slot.sentRight || flags != slot.sentFlags;
+    if (changed && now - slot.lastStateMs >= WS_STATE_MIN_MS) {
+        sendWebSocketState(slot, 0, WS_STATUS_OK);
+    } else if (now - slot.lastRxMs >= WS_PING_INTERVAL_MS && now - slot.lastPingMs >= WS_PING_INTERVAL_MS) {
+        // Quiet peer: ask for a pong. Paced on its own timer because
+        // telemetry frames keep lastTxMs fresh.
+        sendWebSocketFrame(slot, WS_OP_PING, nullptr, 0);
+        slot.lastPingMs = now;
+    }
+}
+
+uint8_t Controller::wsStatus(WidgetStatus status) {
+    if (status == WIDGET_BAD_ID) return WS_STATUS_BAD_ID;
+    if (status == WIDGET_BUSY) return WS_STATUS_BUSY;
+    return WS_STATUS_OK;
+}
+
+void Controller::handleWebSocketMessage(ClientSlot& slot, const uint8_t* data, uint8_t len) {
+    if (len == 0) return;
+
+    const uint8_t type = data[0];
+    uint8_t status = WS_STATUS_BAD_MSG;
+
+    switch (type) {
+        case WS_MSG_DRIVE:
+            if (len >= 4) {
+                // Optional fifth byte: rotation / right stick (r)
+                DriveInput in;
+                in.x = (int8_t)data[1];
+                in.y = (int8_t)data[2];
+                in.t = data[3];
+                if (len >= 5) in.r = (int8_t)data[4];
+                applyDriveCommand(in);
+                status = WS_STATUS_OK;
+            }
+            break;
+
+        case WS_MSG_SLIDER:
+            if (len >= 4) {
+                const int v = (int16_t)((uint16_t)data[2] | ((uint16_t)data[3] << 8));
+                status = wsStatus(_widgets->setSlider(data[1], v));
+            }
+            break;
+
+        case WS_MSG_BUTTON:
+            if (len >= 2) {
+                status = wsStatus(_widgets->press(data[1]));
+            }
+            break;
+
+        case WS_MSG_TELEMETRY:
+            if (len >= 2) {
+                // Replaces /events for this page, saving it a connection
+                slot.wsTelemetry = data[1] != 0;
+                status = WS_STATUS_OK;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    sendWebSocketState(slot, type, status);
+}
+
+void Controller::sendWebSocketFrame(ClientSlot& slot, uint8_t opcode, const uint8_t* payload, uint8_t len) {
+    // Header and payload go out in a single write
+    uint8_t frame[4 + WebSocketFrameParser::MAX_PAYLOAD];
+    if (len > WebSocketFrameParser::MAX_PAYLOAD) len = WebSocketFrameParser::MAX_PAYLOAD;
+
+    uint8_t n = webSocketFrameHeader(opcode, len, frame);
+    if (len > 0) memcpy(frame + n, payload, len);
+    slot.client.write(frame, n + len);
+    slot.lastTxMs = millis();
+}
+
+void Controller::sendWebSocketState(ClientSlot& slot, uint8_t ackType, uint8_t status) {
+    const uint8_t flags = _failsafeStopped ? 1 : 0;
+    const uint8_t msg[6] = {
+        WS_MSG_STATE, ackType, status,
+        (uint8_t)_out[0], (uint8_t)_out[1], flags
+    };
+    sendWebSocketFrame(slot, WS_OP_BINARY, msg, sizeof(msg));
+
+    slot.lastStateMs = slot.lastTxMs;
+    slot.sentLeft = _out[0];
+    slot.sentRight = _out[1];
+    slot.sentFlags = flags;
+}
+
+void Controller::sendWebSocketTelemetry(ClientSlot& slot) {
+    // A text frame announces its length up front: measure the JSON first,
+    // then header and payload share one buffered write
+    uint8_t scratch[16];
+    ResponseWriter counter(scratch, sizeof(scratch), countBytes, nullptr);
+    writeTelemetryJson(counter);
+    counter.flush();
+
+    uint8_t header[4];
+    const uint8_t n = webSocketFrameHeader(WS_OP_TEXT, (uint16_t)counter.bytesWritten(), header);
+
+    ResponseWriter w = openWriter(slot.client);
+    w.write(header, n);
+    writeTelemetryJson(w);
+    w.flush();
+    slot.lastTxMs = millis();
+}
+
+// -------------------- UDP drive listener --------------------
+
+bool Controller::beginUdp(uint16_t port) {
+    if (!_udp.begin(port)) {
+        Serial.println("[UDP] Failed to open drive listener");
+        return false;
+    }
+
+    _udpSeq.reset();
+    _udpEnabled = true;
+
+    Serial.print("[UDP] Drive listener on port ");
+    Serial.println(port);
+    return true;
+}
+
+void Controller::serviceUdp() {
+    // Drain what is queued and keep only the newest valid command, so a burst
+    // released after a stall collapses into a single update
+    UdpDrivePacket newest;
+    bool haveNewest = false;
+
+    for (uint8_t i = 0; i < UDP_MAX_PACKETS_PER_UPDATE; i++) {
+        int size = _udp.parsePacket();
+        if (size <= 0) break;
+
+        uint8_t buf[UDP_DRIVE_PACKET_SIZE];
+        if (size != UDP_DRIVE_PACKET_SIZE) {
+            _udp.flush();
+            _udpStats.invalid++;
+            continue;
+        }
+        _udp.read(buf, sizeof(buf));
+
+        UdpDrivePacket pkt;
+        if (!decodeUdpDrivePacket(buf, sizeof(buf), pkt)) {
+            _udpStats.invalid++;
+            continue;
+        }
+        // A sender silent for longer than the failsafe window may have restarted
+        const unsigned long resyncMs = _failsafeTimeoutMs > 0 ? _failsafeTimeoutMs : 1000;
+        if (!_udpSeq.accept(pkt.seq, millis(), resyncMs)) {
+            _udpStats.stale++;
+            continue;
+        }
+
+        _udpStats.accepted++;
+        newest = pkt;
+        haveNewest = true;
+    }
+
+    // Only accepted packets refresh _lastDriveMs: lost packets let failsafe trip
+    if (haveNewest) {
+        DriveInput in;
+        in.x = newest.x;
+        in.y = newest.y;
+        in.t = newest.t;
+        applyDriveCommand(in);
+    }
+}
+
+void Controller::sendHttpOk(WiFiClient& client, const char* contentType, const char* body) {
+    ResponseWriter w = beginResponse(client, 200, "OK");
+    w.header("Content-Type", contentType);
+    printConnectionHeaders(w);
+    w.header("Content-Length", (unsigned long)strlen(body));
+    w.endHeaders();
+    w.print(body);
+    w.flush();
+}
+
+void Controller::sendHttpNotFound(WiFiClient& client) {
+    static const char body[] = "Not Found";
+    ResponseWriter w = beginResponse(client, 404, "Not Found");
+    w.header("Content-Type", "text/plain; charset=utf-8");
+    printConnectionHeaders(w);
+    w.header("Content-Length", (unsigned long)(sizeof(body) - 1));
+    w.endHeaders();
+    w.print(body);
+    w.flush();
+}
+
+int Controller::clampInt(int v, int lo, int hi) {
+    if (v < lo) return lo;
+    if (v > hi) return hi;
+    return v;
+}
+
+void Controller::dispatchRequest(WiFiClient& client, const HttpRequest& req) {
+    if (req.isGet("/")) {
+        handleRoot(client, req);
         setLedStateHold(LED_CLIENT_CONNECTED, 2000);
         return;
     }
 
-    if (requestLine.startsWith("GET /drive")) {
-        handleDrive(client, requestLine);
+    if (req.isGet("/ui.json")) {
+        handleUiManifest(client, req);
+        return;
+    }
+
+    if (req.isGet("/drive")) {
+        handleDrive(client, req);
         return;
     }
 
-    if (requestLine.startsWith("GET /btn?")) {
-        handleBtn(client, requestLine);
+    if (req.isGet("/btn")) {
+        handleBtn(client, req);
         return;
     }
-    if (requestLine.startsWith("GET /sld?")) {
-        handleSlider(client, requestLine);
+    if (req.isGet("/sld")) {
+        handleSlider(client, req);
         return;
     }
 
-    if (requestLine.startsWith("GET /control?msg=")) {
-        handleControlMsg(client, requestLine);
+    if (req.isGet("/control") && req.param("msg")) {
+        handleControlMsg(client, req);
         return;
     }
 
-    if (requestLine.startsWith("GET /health ")) {
+    if (req.isGet("/health")) {
         handleHealth(client);
         return;
     }
 
+#if CONTROLLER_METRICS
+    if (req.isGet("/metrics")) {
+        handleMetrics(client, req);
+        return;
+    }
+#endif
+
+#if CONTROLLER_PROFILER
+    if (req.isGet("/profile")) {
+        handleProfile(client, req);
+        return;
+    }
+#endif
+
     sendHttpNotFound(client);
 }
 
@@ -334,121 +1229,84 @@ void Controller::handleHealth(WiFiClient& client) {
     sendHttpOk(client, "text/plain; charset=utf-8", "OK");
 }
 
-void Controller::handleControlMsg(WiFiClient& client, const String& requestLine) {
-    int start = String("GET /control?msg=").length();
-    int end = requestLine.indexOf(' ', start);
-    String msg = (end > start) ? requestLine.substring(start, end) : "";
-    msg.replace("+", " ");
-
-    if (_onMessage) _onMessage(msg);
+void Controller::handleControlMsg(WiFiClient& client, const HttpRequest& req) {
+    // Already '+' / %XX decoded by the request parser
+    const char* msg = req.param("msg");
 
-    sendHttpOk(client, "text/plain; charset=utf-8", "OK");
+    sendWidgetStatus(client, _widgets->message(msg));
 }
 
 bool Controller::registerSlider(const char* label, void (*cb)(int value),
                                 int minVal, int maxVal, int initial, int step) {
-    if (_sliderCount >= MAX_SLIDERS) return false;
-    if (minVal > maxVal) { int tmp = minVal; minVal = maxVal; maxVal = tmp; }
-    if (step <= 0) step = 1;
-
-    initial = clampInt(initial, minVal, maxVal);
-
-    _sliders[_sliderCount].label  = label;
-    _sliders[_sliderCount].minVal = minVal;
-    _sliders[_sliderCount].maxVal = maxVal;
-    _sliders[_sliderCount].step   = step;
-    _sliders[_sliderCount].value  = initial;
-    _sliders[_sliderCount].cb     = cb;
-
-    _sliderCount++;
-    return true;
+    return _widgets->addSlider(label, cb, minVal, maxVal, initial, step);
 }
 
 void Controller::clearSliders() {
-    _sliderCount = 0;
+    _widgets->clearSliders();
 }
 
-void Controller::handleBtn(WiFiClient& client, const String& requestLine) {
+void Controller::handleBtn(WiFiClient& client, const HttpRequest& req) {
     int id = -1;
-    if (!extractQueryInt(requestLine, "id", id)) {
+    if (!req.paramInt("id", id)) {
         sendHttpOk(client, "text/plain; charset=utf-8", "Missing id");
         return;
     }
 
-    if (id < 0 || id >= (int)_buttonCount) {
-        sendHttpOk(client, "text/plain; charset=utf-8", "Bad id");
-        return;
-    }
-
-    if (_buttons[id].cb) _buttons[id].cb();
-
-    if (_onMessage) _onMessage(String("btn:") + _buttons[id].label);
+    sendWidgetStatus(client, _widgets->press(id));
+}
 
-    sendHttpOk(client, "text/plain; charset=utf-8", "OK");
+void Controller::sendWidgetStatus(WiFiClient& client, WidgetStatus status) {
+    const char* body = "OK";
+    if (status == WIDGET_BAD_ID) body = "Bad id";
+    else if (status == WIDGET_BUSY) body = "Busy";
+    sendHttpOk(client, "text/plain; charset=utf-8", body);
 }
-void Controller::handleSlider(WiFiClient& client, const String& requestLine) {
+
+void Controller::handleSlider(WiFiClient& client, const HttpRequest& req) {
     int id = -1;
     int v  = 0;
 
-    if (!extractQueryInt(requestLine, "id", id)) {
+    if (!req.paramInt("id", id)) {
         sendHttpOk(client, "text/plain; charset=utf-8", "Missing id");
         return;
     }
-    if (!extractQueryInt(requestLine, "v", v)) {
+    if (!req.paramInt("v", v)) {
         sendHttpOk(client, "text/plain; charset=utf-8", "Missing v");
         return;
     }
 
-    if (id < 0 || id >= (int)_sliderCount) {
-        sendHttpOk(client, "text/plain; charset=utf-8", "Bad id");
-        return;
-    }
-
-    // Clamp + store
-    v = clampInt(v, _sliders[id].minVal, _sliders[id].maxVal);
-    _sliders[id].value = v;
-
-    // Call callback
-    if (_sliders[id].cb) _sliders[id].cb(v);
-
-    // Optional message callback (consistent with buttons)
-    if (_onMessage) _onMessage(String("sld:") + _sliders[id].label + "=" + String(v));
-
-    sendHttpOk(client, "text/plain; charset=utf-8", "OK");
+    sendWidgetStatus(client, _widgets->setSlider(id, v));
 }
 
-void Controller::handleDrive(WiFiClient& client, const String& requestLine) {
-    int x = 0;   // -100..100
-    int y = 0;   // -100..100
-    int t = 100; // 0..100
+void Controller::handleDrive(WiFiClient& client, const HttpRequest& req) {
+    DriveInput in;   // x, y, r: -100..100, t: 0..100
 
-    extractQueryInt(requestLine, "x", x);
-    extractQueryInt(requestLine, "y", y);
-    extractQueryInt(requestLine, "t", t);
+    req.paramInt("x", in.x);
+    req.paramInt("y", in.y);
+    req.paramInt("r", in.r);
+    req.paramInt("t", in.t);
 
-    x = clampInt(x, -100, 100);
-    y = clampInt(y, -100, 100);
-    t = clampInt(t, 0, 100);
+    applyDriveCommand(in);
 
-    int left  = clampInt(y + x, -100, 100);
-    int right = clampInt(y - x, -100, 100);
+    // Optional debug prints (beware: will spam if heartbeat is enabled)
+    // Serial.print("Drive: L="); Serial.print(_cmd[0]);
+    // Serial.print(" R="); Serial.println(_cmd[1]);
 
-    left  = (left * t) / 100;
-    right = (right * t) / 100;
+    sendHttpOk(client, "text/plain; charset=utf-8", "OK");
+}
 
-    _cmdLeft = (int8_t)left;
-    _cmdRight = (int8_t)right;
+void Controller::applyDriveCommand(const DriveInput& in) {
+    // Deadband + response curve per stick axis, then mix
+    DriveInput shaped = in;
+    shaped.x = _inputCurve(clampInt(in.x, -100, 100));
+    shaped.y = _inputCurve(clampInt(in.y, -100, 100));
+    shaped.r = _inputCurve(clampInt(in.r, -100, 100));
+    mixDrive(_driveMode, shaped, _cmd);
 
     _lastDriveMs = millis();
-    _failsafeStopped = false;
+    publishDriveTarget();
 
     setLedStateHold(LED_CLIENT_CONNECTED, 1000);
-
-    // Optional debug prints (beware: will spam if heartbeat is enabled)
-    // Serial.print("Drive: L="); Serial.print(_cmdLeft);
-    // Serial.print(" R="); Serial.println(_cmdRight);
-
-    sendHttpOk(client, "text/plain; charset=utf-8", "OK");
 }
 
 void Controller::enableStatusLED(uint8_t pin) {
@@ -532,254 +1390,125 @@ void Controller::updateStatusLED() {
     }
 }
 
-void Controller::handleRoot(WiFiClient& client) {
-    String buttonsHtml;
-    for (uint8_t i = 0; i < _buttonCount; i++) {
-        buttonsHtml += "<button class='uBtn' data-id='";
-        buttonsHtml += i;
-        buttonsHtml += "'>";
-        buttonsHtml += _buttons[i].label;
-        buttonsHtml += "</button> ";
-    }
-    if (_buttonCount == 0) {
-        buttonsHtml = "<div style='opacity:.7'>No buttons registered</div>";
-    }
-    String slidersHtml;
-    for (uint8_t i = 0; i < _sliderCount; i++) {
-        slidersHtml += "<div class='row sldRow'>";
-        slidersHtml += "  <div class='thrHeader'>";
-        slidersHtml += "    <div class='thrLabel'>";
-        slidersHtml += _sliders[i].label;
-        slidersHtml += "    </div>";
-        slidersHtml += "    <div class='thrValue'><span class='sldVal' data-id='";
-        slidersHtml += i;
-        slidersHtml += "'>";
-        slidersHtml += _sliders[i].value;
-        slidersHtml += "</span></div>";
-        slidersHtml += "  </div>";
-        slidersHtml += "  <input class='thr uSld' data-id='";
-        slidersHtml += i;
-        slidersHtml += "' type='range' min='";
-        slidersHtml += _sliders[i].minVal;
-        slidersHtml += "' max='";
-        slidersHtml += _sliders[i].maxVal;
-        slidersHtml += "' value='";
-        slidersHtml += _sliders[i].value;
-        slidersHtml += "' step='";
-        slidersHtml += _sliders[i].step;
-        slidersHtml += "'/>";
-        slidersHtml += "</div>";
-    }
-    if (_sliderCount == 0) {
-        slidersHtml = "<div class='row' style='opacity:.7'>No sliders registered</div>";
-    }
-
-    String page;
-    page.reserve(7500);
-
-    page += "<!doctype html><html><head><meta charset='utf-8'/>";
-    page += "<meta name='viewport' content='width=device-width,initial-scale=1'/>";
-    page += "<title>Robot Controller</title>";
-    page += "<style>";
-  page += "#thrRow{margin-top:10px;}";
-  page += ".thrHeader{display:flex;align-items:center;justify-content:space-between;margin-bottom:10px;}";
-  page += ".thrLabel{font-size:16px;font-weight:600;}";
-  page += ".thrValue{font-size:16px;font-variant-numeric:tabular-nums;opacity:.9;}";
-
-// Make the slider easy to drag
-  page += "input.thr{width:100%;height:42px;-webkit-appearance:none;appearance:none;background:transparent;touch-action:none;}";
-
-// Track
-  page += "input.thr::-webkit-slider-runnable-track{height:12px;border-radius:999px;background:#ddd;border:1px solid #333;}";
-  page += "input.thr::-moz-range-track{height:12px;border-radius:999px;background:#ddd;border:1px solid #333;}";
-
-// Thumb (big + easy to grab)
-  page += "input.thr::-webkit-slider-thumb{-webkit-appearance:none;appearance:none;width:34px;height:34px;border-radius:50%;background:#333;border:2px solid #fff;margin-top:-12px;box-shadow:0 2px 6px rgba(0,0,0,.25);}";
-  page += "input.thr::-moz-range-thumb{width:34px;height:34px;border-radius:50%;background:#333;border:2px solid #fff;box-shadow:0 2px 6px rgba(0,0,0,.25);}";
-
-// Optional: show active focus without ugly outline
-    page += "input.thr:focus{outline:none;}";
-    page += "body{font-family:system-ui,Arial;margin:16px;}";
-    page += "#wrap{max-width:520px;margin:0 auto;}";
-    page += ".row{margin:14px 0;}";
-    page += "button{padding:12px 16px;font-size:16px;border-radius:12px;border:1px solid #333;background:#f2f2f2;}";
-    page += ".uBtn{margin:6px 8px 6px 0;}";
-    page += "#joy{width:260px;height:260px;border:2px solid #333;border-radius:18px;";
-    page += "touch-action:none; position:relative; user-select:none; -webkit-user-select:none;}";
-    page += "#stick{width:70px;height:70px;border-radius:50%;background:#333;opacity:.85;";
-    page += "position:absolute;left:95px;top:95px;}";
-    page += "label{display:block;margin-bottom:6px;}";
-    page += "input[type=range]{width:100%;}";
-    page += "#status{font-family:ui-monospace,Menlo,monospace; white-space:pre;}";
-    page += "</style></head><body><div id='wrap'>";
-    page += "<h2>Robot Controller</h2>";
-
-    page += "<div class='row' id='buttons'>";
-    page += buttonsHtml;
-    page += "</div>";
-
-    page += "<div class='row' id='sliders'>";
-    page += slidersHtml;
-    page += "</div>";
-
-    page += "<div class='row'><div id='joy'><div id='stick'></div></div></div>";
-
-    page += "<div class='row' id='thrRow'>";
-    page += "  <div class='thrHeader'>";
-    page += "    <div class='thrLabel'>Throttle</div>";
-    page += "    <div class='thrValue'><span id='tval'>100</span>%</div>";
-    page += "  </div>";
-    page += "  <input id='thr' class='thr' type='range' min='0' max='100' value='100' step='1'/>";
-    page += "</div>";
-
-    // --- JS (STOP priority even if a request is in-flight) + HEARTBEAT resend ---
-    page += "<script>";
-    page += "let x=0,y=0,t=100;";
-    page += "const joy=document.getElementById('joy');";
-    page += "const stick=document.getElementById('stick');";
-    page += "const thr=document.getElementById('thr');";
-    page += "const tval=document.getElementById('tval');";
-    page += "const status=document.getElementById('status');";
-
-    page += "function clamp(v,a,b){return Math.max(a,Math.min(b,v));}";
-    page += "function setStick(px,py){stick.style.left=(px-35)+'px'; stick.style.top=(py-35)+'px';}";
-    page += "function updateStatus(extra=''){status.textContent=`x=${x} y=${y} t=${t}` + (extra?('\\n'+extra):'');}";
-
-    // Dynamic buttons
-    page += "document.querySelectorAll('.uBtn').forEach(b=>{";
-    page += "  b.addEventListener('click',()=>{";
-    page += "    const id=b.getAttribute('data-id');";
-    page += "    fetch(`/btn?id=${id}&_=${Date.now()}`, {cache:'no-store'}).catch(()=>{});";
-    page += "    updateStatus('btn id=' + id);";
-    page += "  });";
-    page += "});";
-
-    // Dynamic sliders
-    // --- Dynamic sliders (add-on sliders like buttons) ---
-    page += "document.querySelectorAll('.uSld').forEach(s=>{";
-    page += "  const id = s.getAttribute('data-id');";
-    page += "  const vEl = document.querySelector(`.sldVal[data-id='${id}']`);";
-    page += "  function sendSlider(){";
-    page += "    const v = parseInt(s.value,10) || 0;";
-    page += "    if (vEl) vEl.textContent = v;";
-    page += "    fetch(`/sld?id=${id}&v=${v}&_=${Date.now()}`, {cache:'no-store'}).catch(()=>{});";
-    page += "  }";
-    page += "  s.addEventListener('input', ()=>{";
-    page += "    sendSlider();";
-    page += "  });";
-    page += "});";
-
-    // --- Drive send logic: 1 in-flight, STOP priority, + heartbeat keepalive ---
-    page += "let inFlight=false;";
-    page += "let pending=false;";
-    page += "let lastSentX=999,lastSentY=999,lastSentT=999;";
-    page += "let lastSendMs=0;";
-    page += "const HEARTBEAT_MS=200;";
-
-    page += "function sendDriveNow(force=false){";
-    page += "  const now=Date.now();";
-    page += "  const same = (x===lastSentX && y===lastSentY && t===lastSentT);";
-    page += "  if (!force && same && (now - lastSendMs) < HEARTBEAT_MS) return;";
-    page += "  const isStop = (x===0 && y===0);";
-
-    // Keep your existing throttle rule, but allow heartbeat sends too
-    page += "  if (inFlight && !isStop){ pending=true; return; }";
-    page += "  if (!isStop){ inFlight=true; pending=false; }";
-
-    page += "  const url=`/drive?x=${x}&y=${y}&t=${t}&_=${now}`;";
-    page += "  lastSendMs=now;";
-
-    page += "  fetch(url,{cache:'no-store', keepalive:true})";
-    page += "    .catch(()=>{})";
-    page += "    .finally(()=>{";
-    page += "      lastSentX=x; lastSentY=y; lastSentT=t;";
-    page += "      if (!isStop){";
-    page += "        inFlight=false;";
-    page += "        if (pending) sendDriveNow(true);";
-    page += "      }";
-    page += "    });";
-    page += "}";
-
-    // Heartbeat: keep sending while held away from center (prevents failsafe)
-    page += "setInterval(()=>{";
-    page += "  if (x!==0 || y!==0) sendDriveNow(false);";
-    page += "}, HEARTBEAT_MS);";
-
-    // Joystick mapping
-    page += "function posToXY(clientX,clientY){";
-    page += "  const r=joy.getBoundingClientRect();";
-    page += "  const cx=clientX - r.left;";
-    page += "  const cy=clientY - r.top;";
-    page += "  const dx=cx - r.width/2;";
-    page += "  const dy=cy - r.height/2;";
-    page += "  const max=r.width/2 - 35;";
-    page += "  const ndx=clamp(dx,-max,max);";
-    page += "  const ndy=clamp(dy,-max,max);";
-    page += "  x=Math.round((ndx/max)*100);";
-    page += "  y=Math.round((-ndy/max)*100);";
-    page += "  if (Math.abs(x) < 4) x=0;";
-    page += "  if (Math.abs(y) < 4) y=0;";
-    page += "  setStick(r.width/2 + ndx, r.height/2 + ndy);";
-    page += "  updateStatus();";
-    page += "  sendDriveNow(true);"; // force immediate send on changes
-    page += "}";
-
-    page += "let dragging=false;";
-    page += "joy.addEventListener('pointerdown',(e)=>{";
-    page += "  dragging=true;";
-    page += "  joy.setPointerCapture(e.pointerId);";
-    page += "  posToXY(e.clientX,e.clientY);";
-    page += "});";
-    page += "joy.addEventListener('pointermove',(e)=>{";
-    page += "  if(!dragging) return;";
-    page += "  posToXY(e.clientX,e.clientY);";
-    page += "});";
-    page += "joy.addEventListener('pointerup',()=>{";
-    page += "  dragging=false;";
-    page += "  x=0; y=0;";
-    page += "  setStick(130,130);";
-    page += "  updateStatus('released');";
-    page += "  sendDriveNow(true);"; // force STOP send
-    page += "});";
-    page += "joy.addEventListener('pointercancel',()=>{";
-    page += "  dragging=false;";
-    page += "  x=0; y=0;";
-    page += "  setStick(130,130);";
-    page += "  updateStatus('cancel');";
-    page += "  sendDriveNow(true);"; // force STOP send
-    page += "});";
-
-    // Slider
-    page += "thr.addEventListener('input',()=>{";
-    page += "  t=parseInt(thr.value,10)||0;";
-    page += "  tval.textContent=t;";
-    page += "  updateStatus('slider');";
-    page += "  sendDriveNow(true);";
-    page += "});";
-
-    page += "updateStatus('ready');";
-    page += "sendDriveNow(true);";
-    page += "</script>";
-
-    page += "</div></body></html>";
-
-    sendHttpOk(client, "text/html; charset=utf-8", page);
-}
-
-// -------------------- L298N implementation --------------------
-
-void Controller::motorInitSafeStop() {
-    // Ensure stopped at boot (BRAKE)
-    digitalWrite(_in1, HIGH);
-    digitalWrite(_in2, HIGH);
-    analogWrite(_ena, 0);
-
-    digitalWrite(_in3, HIGH);
-    digitalWrite(_in4, HIGH);
-    analogWrite(_enb, 0);
-}
-
-void Controller::speedToCmd(int8_t spd, bool &forward, uint8_t &pwm) {
+// /ui.json uses the same generators as the page template
+static const TemplateFragment kUiManifestTemplate[] = {
+    { "{\"throttle\":", 0, CONTROLLER_UI_SLOT_THROTTLE },
+    { ",\"failsafeMs\":", 0, CONTROLLER_UI_SLOT_FAILSAFE },
+    { ",\"mode\":", 0, CONTROLLER_UI_SLOT_MODE },
+    { ",\"buttons\":[", 0, CONTROLLER_UI_SLOT_BUTTONS },
+    { "],\"sliders\":[", 0, CONTROLLER_UI_SLOT_SLIDERS },
+    { "]}", 0, TEMPLATE_NO_SLOT },
+};
+
+void Controller::handleRoot(WiFiClient& client, const HttpRequest& req) {
+    // Revalidation after a reload or reconnect costs one small response
+    char etag[UI_ETAG_SIZE];
+    formatUiEtag(req.acceptsGzip, etag);
+    if (req.etagMatches(etag)) {
+        ResponseWriter w = beginResponse(client, 304, "Not Modified");
+        w.header("ETag", etag);
+        w.header("Cache-Control", "no-cache");
+        w.header("Vary", "Accept-Encoding");
+        printConnectionHeaders(w);
+        w.endHeaders();
+        w.flush();
+        return;
+    }
+
+    if (!req.acceptsGzip) {
+        // Widgets inlined by the template (scripts/embed_ui.py), no /ui.json round trip
+        sendTemplate(client, req, "text/html; charset=utf-8", etag,
+                     CONTROLLER_UI_TEMPLATE, CONTROLLER_UI_TEMPLATE_COUNT);
+        return;
+    }
+
+    // Static gzipped shell from flash; it fetches /ui.json itself
+    ResponseWriter w = beginResponse(client, 200, "OK");
+    w.header("Content-Type", "text/html; charset=utf-8");
+    w.header("Content-Encoding", "gzip");
+    w.header("ETag", etag);
+    w.header("Cache-Control", "no-cache");
+    w.header("Vary", "Accept-Encoding");
+    printConnectionHeaders(w);
+    w.header("Content-Length", (unsigned long)CONTROLLER_UI_GZ_LEN);
+    w.endHeaders();
+
+    // Headers share the first transfer; the rest goes straight from flash
+    w.write(CONTROLLER_UI_GZ, CONTROLLER_UI_GZ_LEN);
+    w.flush();
+}
+
+void Controller::handleUiManifest(WiFiClient& client, const HttpRequest& req) {
+    sendTemplate(client, req, "application/json", nullptr,
+                 kUiManifestTemplate, sizeof(kUiManifestTemplate) / sizeof(kUiManifestTemplate[0]));
+}
+
+void Controller::sendTemplate(WiFiClient& client, const HttpRequest& req, const char* contentType,
+                              const char* etag, const TemplateFragment* fragments, uint8_t count) {
+    ResponseWriter w = beginStreamedResponse(client, req, contentType, etag);
+    renderTemplate(fragments, count, renderUiSlot, this, w);
+    w.finish();
+}
+
+void Controller::formatUiEtag(bool gzip, char* out) {
+    // "<page hash>" for the static shell; the rendered page adds the widgets
+    static const char hex[] = "0123456789abcdef";
+    uint8_t n = 0;
+    out[n++] = '"';
+    for (const char* h = CONTROLLER_UI_HASH; *h; h++) out[n++] = *h;
+    if (!gzip) {
+        const uint32_t reg = uiRegistryHash();
+        out[n++] = '-';
+        for (int8_t shift = 28; shift >= 0; shift -= 4) out[n++] = hex[(reg >> shift) & 0xF];
+    }
+    out[n++] = '"';
+    out[n] = '\0';
+}
+
+uint32_t Controller::uiRegistryHash() {
+    // Widget labels and settings (cached by the registry) plus the page's
+    // initial throttle, the failsafe window it paces against and the drive
+    // mode that decides whether it shows the rotate control
+    const uint32_t settings = ((uint32_t)_driveMode << 24) | ((uint32_t)_failsafeTimeoutMs << 8)
+                            | DEFAULT_THROTTLE;
+    return _widgets->hash() ^ (settings * 2654435761UL);
+}
+
+void Controller::renderUiSlot(void* ctx, uint8_t slot, ResponseWriter& out) {
+    static_cast<Controller*>(ctx)->writeUiSlot(slot, out);
+}
+
+void Controller::writeUiSlot(uint8_t slot, ResponseWriter& out) const {
+    switch (slot) {
+        case CONTROLLER_UI_SLOT_THROTTLE:
+            out.print((int)DEFAULT_THROTTLE);
+            break;
+
+        case CONTROLLER_UI_SLOT_FAILSAFE:
+            // The page paces its heartbeat to stay inside this window
+            out.print((long)_failsafeTimeoutMs);
+            break;
+
+        case CONTROLLER_UI_SLOT_MODE:
+            // Tank and mecanum need the page's rotate control for r
+            out.print('"');
+            out.print(driveModeName(_driveMode));
+            out.print('"');
+            break;
+
+        case CONTROLLER_UI_SLOT_BUTTONS:
+            _widgets->writeButtonsJson(out);
+            break;
+
+        case CONTROLLER_UI_SLOT_SLIDERS:
+            _widgets->writeSlidersJson(out);
+            break;
+    }
+}
+
+// -------------------- Motor debug --------------------
+
+void Controller::speedToCmd(int8_t spd, bool &forward, uint16_t &duty) const {
     int s = spd; // -100..100
     if (s >= 0) {
         forward = true;
@@ -787,31 +1516,7 @@ void Controller::speedToCmd(int8_t spd, bool &forward, uint8_t &pwm) {
         forward = false;
         s = -s;
     }
-    s = constrain(s, 0, 100);
-    pwm = (uint8_t)map(s, 0, 100, 0, 255);
-}
-
-void Controller::setMotorOne(uint8_t en, uint8_t inA, uint8_t inB, int8_t spd) {
-    int s = spd;
-    if (s > 0) {
-        digitalWrite(inA, HIGH);
-        digitalWrite(inB, LOW);
-    } else if (s < 0) {
-        digitalWrite(inA, LOW);
-        digitalWrite(inB, HIGH);
-        s = -s;
-    } else {
-        // BRAKE (stops faster than coast)
-        digitalWrite(inA, HIGH);
-        digitalWrite(inB, HIGH);
-        analogWrite(en, 0);
-        return;
-    }
-
-    int pwm = map(constrain(s, 0, 100), 0, 100, 0, 255);
-  // to prevent motor whining when starting from rest, we can enforce a minimum PWM threshold (tune as needed)
-    if (pwm > 0 && pwm < _motorMinPWM) pwm = _motorMinPWM;
-    analogWrite(en, pwm);
+    duty = _pwmTable[s > 100 ? 100 : s];
 }
 
 void Controller::debugMotors(int8_t left, int8_t right) {
@@ -824,29 +1529,25 @@ void Controller::debugMotors(int8_t left, int8_t right) {
     if (!changed && !timeOk) return;
 
     bool lfwd, rfwd;
-    uint8_t lpwm, rpwm;
-    speedToCmd(left, lfwd, lpwm);
-    speedToCmd(right, rfwd, rpwm);
+    uint16_t lduty, rduty;
+    speedToCmd(left, lfwd, lduty);
+    speedToCmd(right, rfwd, rduty);
 
     Serial.print("[MOTOR] L=");
     Serial.print(left);
     Serial.print(lfwd ? " FWD " : " REV ");
-    Serial.print("PWM=");
-    Serial.print(lpwm);
+    Serial.print("DUTY=");
+    Serial.print(lduty);
 
     Serial.print(" | R=");
     Serial.print(right);
     Serial.print(rfwd ? " FWD " : " REV ");
-    Serial.print("PWM=");
-    Serial.println(rpwm);
+    Serial.print("DUTY=");
+    Serial.println(rduty);
 
     _lastDbgL = left;
     _lastDbgR = right;
     _lastDbgPrintMs = now;
 }
 
-void Controller::motorApply(int8_t left, int8_t right) {
-    debugMotors(left, right);
-    setMotorOne(_ena, _in1, _in2, left);
-    setMotorOne(_enb, _in3, _in4, right);
-}
\ No newline at end of file
+#endif // defined(ARDUINO)
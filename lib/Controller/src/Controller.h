@@ -7,6 +7,39 @@
 
 #include <Arduino.h>
 #include <WiFiS3.h>
+#include <WiFiUdp.h>
+#include <FspTimer.h>
+
+#include "DriveKinematics.h"
+#include "HttpRequestParser.h"
+#include "MotionProfile.h"
+#include "MotorDriver.h"
+#include "ResponseCurve.h"
+#include "ResponseWriter.h"
+#include "SpeedControl.h"
+#include "Template.h"
+#include "UdpDrive.h"
+#include "WebSocket.h"
+#include "WidgetRegistry.h"
+
+// Request latency histograms (/metrics) take about 1.8 KB of RAM. Build with
+// -DCONTROLLER_METRICS=0 to leave them out.
+#ifndef CONTROLLER_METRICS
+#define CONTROLLER_METRICS 1
+#endif
+
+// The loop profiler (/profile) takes about 1 KB. Build with
+// -DCONTROLLER_PROFILER=0 to leave it out.
+#ifndef CONTROLLER_PROFILER
+#define CONTROLLER_PROFILER 1
+#endif
+
+#if CONTROLLER_METRICS
+#include "LatencyHistogram.h"
+#endif
+#if CONTROLLER_PROFILER
+#include "LoopProfiler.h"
+#endif
 
 class Controller {
 public:
@@ -16,20 +49,97 @@ public:
     bool beginAP(bool debug = false);
     void update();
 
-    // Optional generic message callback
-    void registerCallback(void (*callback)(const String&));
+    // Optional: one callback for every button press, slider change and
+    // /control message, after the widget's own callback (see WidgetEvent).
+    // Runs from update(), never inside a request; ctx is passed through.
+    void registerEventCallback(WidgetEventCallback callback, void* ctx = nullptr);
 
     // Optional: called whenever smoothed motor outputs change
     // (Still available even if L298N is configured internally)
     void registerDriveCallback(void (*callback)(int8_t left, int8_t right));
 
-    // Smoothed motor outputs (-100..100)
+    // How stick input maps to motors (call before beginAP). Arcade by
+    // default; DRIVE_MECANUM drives four outputs (see DriveKinematics.h).
+    void setDriveMode(DriveMode mode);
+    DriveMode driveMode() const { return _driveMode; }
+    uint8_t motorCount() const { return _motorCount; }
+
+    // Optional: called with every motor output when any of them changes
+    void registerMotorCallback(void (*callback)(const int8_t* speeds, uint8_t count));
+
+    // Smoothed motor outputs (-100..100); left/right are outputs 0 and 1
     int8_t speedLeft() const;
     int8_t speedRight() const;
+    int8_t speed(uint8_t motor) const;
 
     void setFailsafeTimeoutMs(uint16_t ms);
 
-    // Register a button shown on the UI; callback called on press
+    // Output ramp rates in units per second (outputs span -100..100), applied
+    // by elapsed time so they do not depend on how often update() runs.
+    // accel: speeding up; decel: slowing toward a non-zero target or
+    // reversing; brake: stick released or failsafe.
+    void setAccelRate(uint16_t unitsPerSec);   // default 400 (0 -> 100 in 250 ms)
+    void setDecelRate(uint16_t unitsPerSec);   // default 800
+    void setBrakeRate(uint16_t unitsPerSec);   // default 1500
+
+    // S-curve ramps: the accel/decel rate itself ramps at this many units per
+    // second squared, which softens current spikes on launches and reversals.
+    // 0 (default) keeps the plain ramp. Braking is never jerk-limited.
+    void setJerkLimit(uint16_t unitsPerSec2);
+
+    // Optional: run ramping, failsafe and the L298N outputs from a hardware
+    // timer interrupt at hz (500-1000 is typical) instead of from update(),
+    // so blocking sketch code no longer freezes the drivetrain. Call after
+    // beginAP(). The drive callback and motor debug prints still run in update().
+    bool beginControlTimer(uint16_t hz = 500);
+    bool controlTimerActive() const { return _controlTimerHz != 0; }
+
+    // Drop a connection that has not finished sending its request within this time
+    void setHttpRequestTimeoutMs(uint16_t ms);
+
+    // Optional UDP drive listener (call after beginAP). Takes 12-byte binary
+    // packets (see UdpDrive.h); stale and duplicate packets are dropped.
+    bool beginUdp(uint16_t port = 4210);
+
+    struct UdpStats {
+        uint32_t accepted;
+        uint32_t stale;      // out-of-order or duplicate sequence number
+        uint32_t invalid;    // wrong size, magic or CRC
+    };
+    UdpStats udpStats() const { return _udpStats; }
+
+    // Persistent connections for /drive, /sld and /btn: an idle connection is
+    // closed after idleTimeoutMs, and after maxRequests requests.
+    // maxRequests = 0 disables keep-alive (every response closes).
+    void setHttpKeepAlive(uint16_t idleTimeoutMs, uint16_t maxRequests);
+
+    // Telemetry pushed every intervalMs: outputs, targets, failsafe, slider
+    // values and loop rate. Goes to /ws connections that subscribed, and to
+    // GET /events (Server-Sent Events) for clients without a WebSocket.
+    // 0 disables both.
+    void setTelemetryIntervalMs(uint16_t intervalMs);
+
+    // Request latency histograms per route and phase (accept, parse, handler,
+    // write), in Prometheus text format. Also served at GET /metrics.
+    // Both do nothing when built with CONTROLLER_METRICS=0.
+    void printMetrics(Print& out);
+    void resetMetrics();
+
+    // Loop profiler: period between update() calls (min/mean/p99/max), time
+    // per update() section and the recent loops. A loop longer than budgetUs
+    // counts as an overrun (0 = off). Also served at GET /profile.
+    // All of these do nothing when built with CONTROLLER_PROFILER=0.
+    void setLoopBudgetUs(uint32_t budgetUs);
+#if CONTROLLER_PROFILER
+    uint32_t loopOverruns() const { return _profiler.overruns(); }
+#else
+    uint32_t loopOverruns() const { return 0; }
+#endif
+    void printLoopProfile(Print& out);
+    void resetLoopProfile();
+
+    // Register a button shown on the UI; callback called on press.
+    // The label is not copied: pass a string literal or other lasting storage.
     bool registerButton(const char* label, void (*cb)());
     void clearButtons();
 
@@ -38,6 +148,11 @@ public:
                     int minVal = 0, int maxVal = 100, int initial = 0, int step = 1);
 	void clearSliders();
 
+    // Room for 8 buttons and 8 sliders is built in. For more, declare a
+    // Widgets<buttons, sliders> next to the controller and attach it before
+    // registering anything; it must outlive the controller.
+    void attachWidgets(WidgetRegistry& widgets);
+
     // -------- L298N integration (optional) --------
     // Call this before beginAP() to let the library drive motors automatically.
     void configureL298N(
@@ -45,15 +160,50 @@ public:
         uint8_t enb, uint8_t in3, uint8_t in4
     );
 
+    // Any other driver, or more motors: a MotorDriver<Policy, N> from
+    // MotorDriver.h (L298N, TB6612, DRV8833) or EscDriver.h (RcEsc).
+    // Motor output i goes to channel i. Call before beginAP(); the driver
+    // must outlive the controller. Replaces configureL298N().
+    template <typename Driver>
+    void attachMotorDriver(Driver& driver) {
+        attachMotorOutput(&driver, &Driver::beginThunk, &Driver::applyThunk);
+    }
+
+    // -------- Wheel encoders (optional) --------
+    // Closed-loop speed: the smoothed left/right outputs become speed
+    // setpoints that a PID per wheel tracks from quadrature encoder counts.
+    // countsPerSec is the encoder speed at full output (4 counts per line).
+    // Channels are counted on both edges in pin interrupts, so use
+    // interrupt-capable pins; swap A and B if a wheel counts backwards.
+    bool configureEncoders(uint8_t leftA, uint8_t leftB,
+                           uint8_t rightA, uint8_t rightB,
+                           uint32_t countsPerSec);
+    void setSpeedPid(float kp, float ki, float kd);   // default 2.0, 10.0, 0.0
+    int32_t encoderCount(uint8_t wheel) const;        // 0 left, 1 right
+    int16_t measuredSpeed(uint8_t wheel) const;       // percent of countsPerSec
+
     // Optional tuning for motor debug printing
     void setMotorDebugPrintIntervalMs(uint16_t ms);
 
   void enableStatusLED(uint8_t pin = LED_BUILTIN);
 
+    // Lowest PWM (0..255) that still turns the motors; speeds 1..100 are
+    // scaled across minPwm..full duty in 16 bits so low speeds stay distinct
 void setMotorMinPWM(uint8_t pwm);
 
+    // Enable-pin PWM frequency for configureL298N(), e.g. 20000 to move the
+    // motor whine above hearing. 0 (default) keeps analogWrite(). Call
+    // before beginAP(); pins without a GPT timer output stay on analogWrite().
+    void setMotorPwmFrequency(uint32_t hz);
+
+    // Stick shaping applied to x, y and r before mixing. Inputs inside
+    // +/-deadband (default 6, max 50) are 0 and the rest of the stick is
+    // stretched so there is no jump at its edge.
+    void setInputCurve(ResponseCurve curve);   // default CURVE_LINEAR
+    void setDeadband(uint8_t deadband);
+
 private:
-	void handleSlider(WiFiClient& client, const String& requestLine);
+	void handleSlider(WiFiClient& client, const HttpRequest& req);
 
 enum LedState {
     LED_BOOTING,
@@ -64,28 +214,141 @@ enum LedState {
 };
     void printWiFiStatus() const;
 
-    void handleClient(WiFiClient& client);
-    String readRequestLine(WiFiClient& client);
-
-    void sendHttpOk(WiFiClient& client, const char* contentType, const String& body);
+    // -------- HTTP connection table --------
+    struct ClientSlot;
+    void acceptClients();
+    void serviceClient(ClientSlot& slot);
+    void closeClient(ClientSlot& slot);
+    void dispatchRequest(WiFiClient& client, const HttpRequest& req);
+    static bool isPersistentRoute(const HttpRequest& req);
+    void printConnectionHeaders(ResponseWriter& w);
+
+    // -------- Buffered responses --------
+    static size_t writeToClient(void* ctx, const uint8_t* data, size_t len);
+    static size_t writeToPrint(void* ctx, const uint8_t* data, size_t len);
+    ResponseWriter openWriter(WiFiClient& client);
+    ResponseWriter beginResponse(WiFiClient& client, uint16_t code, const char* reason);
+    ResponseWriter beginStreamedResponse(WiFiClient& client, const HttpRequest& req,
+                                         const char* contentType, const char* etag);
+
+    // -------- Request metrics (/metrics) --------
+    enum MetricRoute : uint8_t {
+        ROUTE_ROOT,
+        ROUTE_UI_JSON,
+        ROUTE_DRIVE,
+        ROUTE_BTN,
+        ROUTE_SLD,
+        ROUTE_WS,
+        ROUTE_EVENTS,
+        ROUTE_OTHER,
+        ROUTE_COUNT
+    };
+    enum MetricPhase : uint8_t {
+        PHASE_ACCEPT,    // connection accepted -> first request byte read
+        PHASE_PARSE,     // first byte -> request complete
+        PHASE_HANDLER,   // handler time, socket writes excluded
+        PHASE_WRITE,     // time inside WiFiClient::write
+        PHASE_COUNT
+    };
+#if CONTROLLER_METRICS
+    static uint8_t metricRoute(const HttpRequest& req);
+    void recordRequestMetrics(const ClientSlot& slot, uint8_t route, unsigned long dispatchUs);
+    void handleMetrics(WiFiClient& client, const HttpRequest& req);
+    void writeMetrics(ResponseWriter& w) const;
+#else
+    static uint8_t metricRoute(const HttpRequest&) { return ROUTE_OTHER; }
+    void recordRequestMetrics(const ClientSlot&, uint8_t, unsigned long) {}
+#endif
+
+    // -------- Loop profiler (/profile) --------
+    enum ProfileSection : uint8_t {
+        PROFILE_NETWORK,     // accept + HTTP/WebSocket/event slots
+        PROFILE_UDP,
+        PROFILE_CONTROL,     // failsafe, smoothing, motor output
+        PROFILE_EVENTS,      // button, slider and message callbacks
+        PROFILE_LED,
+        PROFILE_TELEMETRY,
+        PROFILE_SECTION_COUNT
+    };
+#if CONTROLLER_PROFILER
+    void handleProfile(WiFiClient& client, const HttpRequest& req);
+    uint32_t profileLoopStart(uint32_t nowUs) { return _profiler.loopStart(nowUs); }
+    void profileMark(ProfileSection section) { _profiler.mark(section, micros()); }
+#else
+    uint32_t profileLoopStart(uint32_t nowUs) {
+        const uint32_t period = _loopStartUs ? nowUs - _loopStartUs : 0;
+        _loopStartUs = nowUs;
+        return period;
+    }
+    void profileMark(ProfileSection) {}
+#endif
+
+    // -------- WebSocket control channel (/ws) --------
+    static bool isWebSocketRoute(const HttpRequest& req);
+    bool handleWebSocketUpgrade(ClientSlot& slot);
+    void serviceWebSocket(ClientSlot& slot);
+    void handleWebSocketMessage(ClientSlot& slot, const uint8_t* data, uint8_t len);
+    void sendWebSocketFrame(ClientSlot& slot, uint8_t opcode, const uint8_t* payload, uint8_t len);
+    void sendWebSocketState(ClientSlot& slot, uint8_t ackType, uint8_t status);
+    void sendWebSocketTelemetry(ClientSlot& slot);
+
+    // -------- UDP drive listener --------
+    void serviceUdp();
+
+    // -------- Telemetry stream (/events) --------
+    static bool isEventStreamRoute(const HttpRequest& req);
+    bool handleEventStreamStart(ClientSlot& slot);
+    void serviceEventStream(ClientSlot& slot);
+    void serviceTelemetry(unsigned long now);
+    void sendTelemetryEvent(ClientSlot& slot);
+    void writeTelemetryJson(ResponseWriter& w);
+    static size_t countBytes(void* ctx, const uint8_t* data, size_t len);
+
+    // Commands shared by HTTP and WebSocket handlers. Buttons, sliders and
+    // messages only queue an event in the widget registry; update()
+    // dispatches them, so a slow callback never delays a reply.
+    void applyDriveCommand(const DriveInput& in);
+    static uint8_t wsStatus(WidgetStatus status);
+
+    void sendHttpOk(WiFiClient& client, const char* contentType, const char* body);
     void sendHttpNotFound(WiFiClient& client);
-
-    void handleRoot(WiFiClient& client);
-    void handleDrive(WiFiClient& client, const String& requestLine);
-    void handleBtn(WiFiClient& client, const String& requestLine);
-    void handleControlMsg(WiFiClient& client, const String& requestLine);
+    void sendWidgetStatus(WiFiClient& client, WidgetStatus status);
+
+    void handleRoot(WiFiClient& client, const HttpRequest& req);
+    void handleUiManifest(WiFiClient& client, const HttpRequest& req);
+    void sendTemplate(WiFiClient& client, const HttpRequest& req, const char* contentType,
+                      const char* etag, const TemplateFragment* fragments, uint8_t count);
+    void formatUiEtag(bool gzip, char* out);
+    uint32_t uiRegistryHash();
+    static void renderUiSlot(void* ctx, uint8_t slot, ResponseWriter& out);
+    void writeUiSlot(uint8_t slot, ResponseWriter& out) const;
+    void handleDrive(WiFiClient& client, const HttpRequest& req);
+    void handleBtn(WiFiClient& client, const HttpRequest& req);
+    void handleControlMsg(WiFiClient& client, const HttpRequest& req);
     void handleHealth(WiFiClient& client);
 
-    static bool extractQueryInt(const String& requestLine, const char* key, int& outValue);
     static int clampInt(int v, int lo, int hi);
 
-    void applySmoothingAndNotify();
-
-    // -------- L298N internals --------
-    void motorInitSafeStop();
-    void motorApply(int8_t left, int8_t right);
-    void setMotorOne(uint8_t en, uint8_t inA, uint8_t inB, int8_t spd);
-    static void speedToCmd(int8_t spd, bool &forward, uint8_t &pwm);
+    // -------- Control step (update() or timer interrupt) --------
+    void controlStep(uint32_t dtUs);
+    void notifyDriveChanges();
+    void publishDriveTarget();
+    static void controlTimerIsr(timer_callback_args_t* args);
+
+    // -------- Wheel encoders --------
+    struct EncoderInput {
+        uint8_t pinA = 255;
+        uint8_t pinB = 255;
+        QuadratureDecoder decoder;
+    };
+    static uint8_t readEncoderPins(const EncoderInput& enc);
+    static void encoderIsr(void* ctx);
+
+    // -------- Motor output --------
+    typedef void (*MotorBeginFn)(void* ctx);
+    typedef void (*MotorApplyFn)(void* ctx, const int8_t* speeds, const uint16_t* dutyTable, uint8_t count);
+    void attachMotorOutput(void* ctx, MotorBeginFn begin, MotorApplyFn apply);
+    void speedToCmd(int8_t spd, bool &forward, uint16_t &duty) const;
     void debugMotors(int8_t left, int8_t right);
 
     // --- WiFi debug helpers (enabled when beginAP(debug=true)) --- // removed CONST
@@ -112,6 +375,7 @@ bool _ledLevel = false;
 private:
 
     uint8_t _motorMinPWM = 0;
+    uint16_t _pwmTable[101];       // speed magnitude -> 16-bit duty, from _motorMinPWM
 
     const char* _ssid;
     const char* _password;
@@ -119,58 +383,160 @@ private:
     WiFiServer _server{80};
     int _status = WL_IDLE_STATUS;
 
+    // Connection table: each slot parses its request incrementally so a slow
+    // client never blocks update()
+    static constexpr uint8_t MAX_CLIENTS = 4;
+    static constexpr uint8_t HTTP_RX_BUDGET = 128;   // max bytes read per slot per update()
+    static constexpr uint16_t HTTP_TX_BUFFER = 512;   // response bytes coalesced per modem write
+    static constexpr uint8_t DEFAULT_THROTTLE = 100;  // page's initial throttle slider
+    static constexpr uint8_t UI_ETAG_SIZE = 32;       // "<page hash>-<registry hash>" + NUL
+
+    uint8_t _txBuf[HTTP_TX_BUFFER];
+    WiFiClient* _txClient = nullptr;   // target of the writer from openWriter()
+    uint32_t _txWriteUs = 0;           // time spent in client writes for this request
+
+#if CONTROLLER_METRICS
+    LatencyHistogram _latency[ROUTE_COUNT][PHASE_COUNT];
+#endif
+
+#if CONTROLLER_PROFILER
+    static constexpr uint32_t DEFAULT_LOOP_BUDGET_US = 20000;
+    LoopProfiler _profiler{PROFILE_SECTION_COUNT};
+#else
+    uint32_t _loopStartUs = 0;         // start of the current update(), for the loop period
+#endif
+
+    struct ClientSlot {
+        WiFiClient client;
+        HttpRequestParser parser;
+        bool active = false;
+        unsigned long lastRxMs = 0;
+        uint16_t requests = 0;          // requests served on this connection
+
+        // Set once the connection has been upgraded on /ws
+        bool webSocket = false;
+        WebSocketFrameParser wsParser;
+        unsigned long lastTxMs = 0;
+        unsigned long lastStateMs = 0;
+        int8_t sentLeft = 0;
+        int8_t sentRight = 0;
+        uint8_t sentFlags = 0;
+        unsigned long lastPingMs = 0;
+        bool wsTelemetry = false;       // subscribed with WS_MSG_TELEMETRY
+
+        // Set once the connection carries the /events stream
+        bool eventStream = false;
+
+        // Request timing for /metrics
+        unsigned long acceptedUs = 0;
+        unsigned long requestStartUs = 0;
+    };
 
-    void (*_onMessage)(const String&) = nullptr;
+    ClientSlot _clients[MAX_CLIENTS];
+    uint16_t _httpRequestTimeoutMs = 2000;
+
+    // Keep-alive
+    uint16_t _httpIdleTimeoutMs = 5000;
+    uint16_t _httpMaxRequests = 100;
+    bool _keepAliveResponse = false;    // decided per request before the handler runs
+    uint16_t _keepAliveRemaining = 0;
+
+    // Binary messages on /ws: first byte is the type
+    enum WsMessage : uint8_t {
+        WS_MSG_DRIVE     = 0x01,   // x:int8, y:int8, t:uint8[, r:int8]
+        WS_MSG_SLIDER    = 0x02,   // id:uint8, value:int16 little-endian
+        WS_MSG_BUTTON    = 0x03,   // id:uint8
+        WS_MSG_TELEMETRY = 0x04,   // on:uint8, telemetry as text frames while set
+        WS_MSG_STATE     = 0x80    // to client: acked type, status, left, right, flags
+    };
+    enum WsStatus : uint8_t {
+        WS_STATUS_OK      = 0,
+        WS_STATUS_BAD_ID  = 1,
+        WS_STATUS_BAD_MSG = 2,
+        WS_STATUS_BUSY    = 3    // event queue full, try again
+    };
+    static constexpr uint16_t WS_PING_INTERVAL_MS = 2000;
+    static constexpr uint16_t WS_IDLE_TIMEOUT_MS  = 6000;   // no frame or pong received
+    static constexpr uint16_t WS_STATE_MIN_MS     = 100;    // unsolicited state push rate limit
+
+    // UDP drive listener
+    static constexpr uint8_t UDP_MAX_PACKETS_PER_UPDATE = 8;
+    WiFiUDP _udp;
+    bool _udpEnabled = false;
+    UdpSequenceFilter _udpSeq;
+    UdpStats _udpStats = { 0, 0, 0 };
+
+    // Telemetry stream: loop stats are windowed per interval and every
+    // /events connection gets the same event
+    static constexpr uint8_t MAX_EVENT_STREAMS = 2;   // leave slots for commands
+    uint16_t _telemetryIntervalMs = 200;
+    unsigned long _telemetryLastMs = 0;
+    uint32_t _loopCount = 0;         // update() calls in the current window
+    uint32_t _loopMaxGapUs = 0;      // longest gap between update() calls in the window
+    uint16_t _loopHz = 0;            // published at the end of each window
+    uint32_t _loopMaxUs = 0;
+
+
+    WidgetEventCallback _onEvent = nullptr;
+    void* _onEventCtx = nullptr;
     void (*_onDrive)(int8_t left, int8_t right) = nullptr;
-
-    // Network target (set by /drive)
-    int8_t _cmdLeft  = 0;
-    int8_t _cmdRight = 0;
+    void (*_onMotors)(const int8_t* speeds, uint8_t count) = nullptr;
+
+    // Network target (set by /drive), one per motor after mixing
+    DriveMode _driveMode = DRIVE_ARCADE;
+    uint8_t _motorCount = 2;
+    int8_t _cmd[DRIVE_MAX_MOTORS] = {};
+
+    // Targets as seen by controlStep(): double-buffered so the timer
+    // interrupt never reads a half-written command
+    struct DriveTarget {
+        int8_t motor[DRIVE_MAX_MOTORS] = {};
+        uint32_t stampMs = 0;   // _lastDriveMs when published
+    };
+    volatile DriveTarget _targets[2];
+    volatile uint8_t _targetIndex = 0;
 
     // Smoothed output (what you apply to motors)
-    int8_t _outLeft  = 0;
-    int8_t _outRight = 0;
+    volatile int8_t _out[DRIVE_MAX_MOTORS] = {};
+    volatile bool _outputsChanged = false;   // drive callback still pending
+
+    // Fixed-rate control tick (beginControlTimer)
+    FspTimer _controlTimer;
+    uint16_t _controlTimerHz = 0;   // 0: control runs from update()
+    uint32_t _controlTickUs = 0;
 
     // Params for smoothing
     uint8_t _deadband = 6;        // +/-6 => treat as 0
-    uint8_t _slewPerUpdate = 8;   // max change per update() call
+    ResponseCurve _inputCurveType = CURVE_LINEAR;
+    CurveTable _inputCurve;       // deadband + curve, rebuilt by the setters
+    uint16_t _accelRate = 400;    // units per second
+    uint16_t _decelRate = 800;
+    uint16_t _brakeRate = 1500;   // faster ramp-down
+    SlewLimiter _slew[DRIVE_MAX_MOTORS];
+    unsigned long _lastSmoothUs = 0;
 
     // Failsafe
     uint16_t _failsafeTimeoutMs = 1200;
-    uint8_t _slewPerUpdateStop = 30;  // faster ramp-down
     unsigned long _lastDriveMs = 0;
-    bool _failsafeStopped = false;
-
-    // Button registry
-    static constexpr uint8_t MAX_BUTTONS = 8;
-
-    struct ButtonReg {
-        String label;
-        void (*cb)() = nullptr;
-    };
-
-    ButtonReg _buttons[MAX_BUTTONS];
-    uint8_t _buttonCount = 0;
-
-// Slider registry
-static constexpr uint8_t MAX_SLIDERS = 8;
-
-struct SliderReg {
-    String label;
-    int minVal = 0;
-    int maxVal = 100;
-    int step   = 1;
-    int value  = 0;              // stored current value
-    void (*cb)(int value) = nullptr;
-};
-
-SliderReg _sliders[MAX_SLIDERS];
-uint8_t _sliderCount = 0;
-
-    // -------- L298N config --------
-    bool _l298nEnabled = false;
-    uint8_t _ena = 255, _in1 = 255, _in2 = 255;
-    uint8_t _enb = 255, _in3 = 255, _in4 = 255;
+    volatile bool _failsafeStopped = false;   // written by controlStep()
+
+    // Buttons and sliders; _widgets points at _builtinWidgets unless the
+    // sketch attached its own
+    Widgets<8, 8> _builtinWidgets;
+    WidgetRegistry* _widgets = &_builtinWidgets;
+
+    // Closed loop (configureEncoders)
+    bool _encodersEnabled = false;
+    EncoderInput _encoders[2];
+    WheelSpeedController _wheelPid[2];
+    int8_t _drive[2] = { 0, 0 };   // last PID outputs sent to the driver
+
+    // -------- Motor driver --------
+    // Set by attachMotorDriver(); configureL298N() attaches _l298n
+    void* _motorCtx = nullptr;
+    MotorBeginFn _motorBegin = nullptr;
+    MotorApplyFn _motorApply = nullptr;
+    MotorDriver<L298N, 2> _l298n;
 
     // Debug options (enabled via beginAP(debug=true))
     bool _debug = false;
@@ -0,0 +1,609 @@
+// Generated by scripts/embed_ui.py from lib/Controller/ui/index.html -- do not edit.
+// Shell: 11176 bytes plain, 4156 bytes gzipped. Template: 6 fragments.
+
+#ifndef THEFORGE2026_CONTROLLER_UI_H
+#define THEFORGE2026_CONTROLLER_UI_H
+
+#include <stdint.h>
+
+#include "Template.h"
+
+enum ControllerUiSlot : uint8_t {
+    CONTROLLER_UI_SLOT_THROTTLE,
+    CONTROLLER_UI_SLOT_FAILSAFE,
+    CONTROLLER_UI_SLOT_MODE,
+    CONTROLLER_UI_SLOT_BUTTONS,
+    CONTROLLER_UI_SLOT_SLIDERS,
+};
+
+// Static shell for clients that send Accept-Encoding: gzip
+static const uint8_t CONTROLLER_UI_GZ[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xb5, 0x5a, 0xfd, 0x73, 0xdb, 0xb8,
+    0xd1, 0xfe, 0x5d, 0x7f, 0x05, 0x3c, 0x49, 0x43, 0xf2, 0x4a, 0x51, 0x92, 0x13, 0xe7, 0x12, 0xc9,
+    0xb4, 0x27, 0x49, 0x93, 0x36, 0x9d, 0x24, 0x6d, 0x6d, 0x5f, 0x7b, 0x99, 0xeb, 0x4d, 0x4d, 0x89,
+    0x90, 0xc5, 0x84, 0x22, 0x55, 0x02, 0xb2, 0xa4, 0x53, 0xf4, 0xbf, 0xf7, 0xd9, 0x05, 0xf8, 0x25,
+    0xcb, 0xbe, 0xeb, 0x3b, 0x6f, 0xef, 0xc6, 0x11, 0x09, 0x2c, 0x16, 0xfb, 0xf1, 0xec, 0x62, 0x17,
+    0xd2, 0xe9, 0x51, 0x9c, 0x4f, 0xf4, 0x66, 0x21, 0xc5, 0x4c, 0xcf, 0xd3, 0xb3, 0xce, 0x69, 0xf9,
+    0x21, 0xa3, 0x18, 0x1f, 0x73, 0xa9, 0x23, 0x31, 0x99, 0x45, 0x85, 0x92, 0x3a, 0x74, 0x96, 0x7a,
+    0xda, 0x7d, 0xe1, 0xf4, 0xca, 0xf1, 0x2c, 0x9a, 0xcb, 0xd0, 0xb9, 0x4d, 0xe4, 0x6a, 0x91, 0x17,
+    0xda, 0x11, 0x93, 0x3c, 0xd3, 0x32, 0x03, 0xdd, 0x2a, 0x89, 0xf5, 0x2c, 0x8c, 0xe5, 0x6d, 0x32,
+    0x91, 0x5d, 0x7e, 0xf1, 0x93, 0x2c, 0xd1, 0x49, 0x94, 0x76, 0xd5, 0x24, 0x4a, 0x65, 0x38, 0x60,
+    0x26, 0x3a, 0xd1, 0xa9, 0x3c, 0xbb, 0xc8, 0xc7, 0xb9, 0x16, 0x6f, 0xb0, 0xb6, 0xc8, 0xd3, 0x54,
+    0x16, 0xa7, 0x3d, 0x33, 0xde, 0x39, 0x55, 0x7a, 0x43, 0x9f, 0x8f, 0xf4, 0xac, 0xb8, 0xc8, 0x57,
+    0xdb, 0x79, 0x54, 0xdc, 0x24, 0x59, 0x57, 0xe7, 0x8b, 0xe1, 0xa0, 0xbf, 0x58, 0x8f, 0x76, 0x9d,
+    0x00, 0x33, 0x7f, 0x82, 0xa0, 0xb2, 0xd8, 0xc6, 0x89, 0x5a, 0xa4, 0xd1, 0x66, 0x38, 0x4d, 0xe5,
+    0x7a, 0x14, 0xa5, 0xc9, 0x4d, 0xd6, 0x4d, 0xb4, 0x9c, 0xab, 0xe1, 0x04, 0x12, 0xc9, 0x62, 0xf4,
+    0x65, 0xa9, 0x74, 0x32, 0xdd, 0x74, 0xad, 0x8c, 0x43, 0xb5, 0x88, 0x20, 0xdb, 0x58, 0xea, 0x95,
+    0x94, 0xd9, 0xc8, 0xb2, 0x86, 0x20, 0x3a, 0x9f, 0x37, 0xb9, 0x7f, 0x88, 0xc6, 0x32, 0xdd, 0x4e,
+    0xb1, 0xa8, 0xab, 0x92, 0x5f, 0xe4, 0x70, 0xf0, 0x1c, 0x53, 0xfc, 0xba, 0x92, 0xc9, 0xcd, 0x4c,
+    0x0f, 0x9f, 0xf7, 0xfb, 0x96, 0xf4, 0xef, 0x51, 0xba, 0x94, 0x07, 0x49, 0x6f, 0xa3, 0x22, 0x89,
+    0xf0, 0x99, 0x2d, 0xe7, 0xb2, 0x48, 0x26, 0x43, 0x1d, 0x8d, 0x97, 0x69, 0x54, 0xd0, 0xbb, 0x1a,
+    0xe5, 0x10, 0x24, 0xd1, 0x9b, 0x61, 0xf0, 0x12, 0x7c, 0x92, 0x6c, 0xb1, 0xd4, 0xc4, 0x6c, 0xcb,
+    0x56, 0x83, 0x24, 0xfd, 0xdf, 0x8d, 0x66, 0x66, 0xa7, 0x67, 0xc7, 0xe0, 0x87, 0x6d, 0xc7, 0x5f,
+    0x13, 0xdd, 0x8d, 0x16, 0x0b, 0x19, 0x15, 0x51, 0x36, 0x91, 0xc3, 0x2c, 0xcf, 0xe4, 0x68, 0xff,
+    0x7d, 0x1c, 0x4d, 0xbe, 0xde, 0x14, 0xf9, 0x32, 0x8b, 0x87, 0x1a, 0xc3, 0xd0, 0xb6, 0x80, 0xd6,
+    0x23, 0x9d, 0x2f, 0x27, 0xb3, 0x6e, 0x34, 0xd1, 0x49, 0x9e, 0x19, 0xc2, 0xc6, 0x9e, 0xc3, 0x61,
+    0xc9, 0x5d, 0xa5, 0x09, 0x6c, 0xda, 0x2d, 0x96, 0x59, 0x16, 0x8d, 0x53, 0xd9, 0x05, 0x8b, 0xc9,
+    0xd7, 0xad, 0x95, 0x63, 0x40, 0x72, 0x8c, 0xf3, 0x82, 0x29, 0xa2, 0x38, 0x59, 0xaa, 0xe1, 0xcb,
+    0x97, 0x2f, 0x69, 0xac, 0xde, 0xf3, 0x51, 0x1c, 0xc7, 0x96, 0x66, 0x38, 0x58, 0xac, 0x85, 0xca,
+    0xc1, 0x51, 0x3c, 0x7a, 0xfa, 0xf4, 0xe9, 0xde, 0x86, 0xf3, 0xfc, 0x17, 0x30, 0xc9, 0x6e, 0xfe,
+    0x97, 0x7b, 0xb4, 0x95, 0xd2, 0xb3, 0xe5, 0x7c, 0xbc, 0xfd, 0xad, 0x76, 0x34, 0x6e, 0x78, 0xfa,
+    0x0c, 0x5b, 0x5b, 0xd1, 0xf8, 0xb9, 0x2d, 0xda, 0x09, 0x9c, 0xd4, 0x14, 0x8c, 0x44, 0xb0, 0x82,
+    0x1d, 0xd7, 0x82, 0x4d, 0xa7, 0xd3, 0x51, 0x03, 0xc2, 0x5d, 0xab, 0xe3, 0xba, 0xab, 0x66, 0x51,
+    0x9c, 0xaf, 0x86, 0x7d, 0x41, 0xc4, 0x00, 0x8d, 0x28, 0x6e, 0xc6, 0x91, 0xdb, 0xf7, 0xe9, 0xff,
+    0xe0, 0xf8, 0xc4, 0xbb, 0xdf, 0x64, 0xac, 0xca, 0xff, 0xb3, 0x88, 0xff, 0xb5, 0x44, 0xd3, 0x7c,
+    0xb2, 0x54, 0xdb, 0x7c, 0xa9, 0xd3, 0x24, 0x93, 0x25, 0xa8, 0xc6, 0x79, 0xbc, 0x31, 0xb1, 0x30,
+    0x8d, 0xe6, 0x49, 0xba, 0x19, 0xaa, 0x8d, 0x42, 0x38, 0x76, 0x97, 0x89, 0xff, 0x0a, 0xc1, 0x90,
+    0x5a, 0x4b, 0x98, 0x20, 0xd9, 0x75, 0x1e, 0xad, 0x8a, 0x68, 0x81, 0x00, 0x5f, 0x9b, 0x6c, 0x31,
+    0x3c, 0x39, 0xa6, 0x10, 0xb4, 0x34, 0x7d, 0x11, 0x2d, 0x75, 0x4e, 0x51, 0x56, 0x54, 0x59, 0x60,
+    0x38, 0x80, 0x8e, 0x82, 0x42, 0x6f, 0xbc, 0x44, 0xcc, 0x66, 0xdb, 0x45, 0x14, 0xc7, 0x49, 0x76,
+    0xc3, 0xc8, 0x11, 0x75, 0xe8, 0xd5, 0x91, 0xd8, 0xb6, 0x47, 0x03, 0x60, 0xfb, 0xe0, 0x69, 0x9a,
+    0x69, 0x7a, 0x4c, 0xff, 0xd3, 0xd6, 0xcb, 0xd7, 0x3a, 0x2b, 0xf7, 0x26, 0x8b, 0xbc, 0xb0, 0x96,
+    0x21, 0x11, 0x1e, 0x7d, 0xc9, 0x37, 0xd6, 0x0d, 0xc7, 0xcf, 0xfb, 0xb5, 0x1f, 0xcc, 0xcb, 0x5d,
+    0x33, 0xd7, 0xc6, 0xaf, 0xc4, 0x01, 0xbb, 0x03, 0xc1, 0xb9, 0xc8, 0x55, 0xc2, 0x6f, 0x85, 0x4c,
+    0x23, 0x9d, 0xdc, 0xca, 0xd1, 0x52, 0x61, 0x91, 0x92, 0xa9, 0x9c, 0x68, 0x43, 0x52, 0x02, 0xf9,
+    0xce, 0x04, 0xc4, 0x42, 0xc6, 0x43, 0x48, 0x19, 0xc1, 0xbe, 0x6f, 0xc8, 0xf5, 0x7d, 0xff, 0x37,
+    0xe1, 0xa3, 0xca, 0x4c, 0x2f, 0x4e, 0x6a, 0x49, 0xa2, 0x31, 0x94, 0x58, 0x6a, 0x39, 0x4a, 0xe5,
+    0x54, 0x0f, 0x5f, 0x9e, 0xb0, 0xdc, 0x0b, 0xf3, 0xb0, 0x4a, 0xd2, 0xb4, 0x8b, 0xc3, 0x02, 0xd8,
+    0x34, 0x59, 0x67, 0x9a, 0x17, 0x73, 0x08, 0x92, 0x72, 0x12, 0x2d, 0x33, 0xf4, 0x38, 0xcd, 0x27,
+    0x5f, 0xf7, 0x32, 0xae, 0x41, 0x01, 0x63, 0xea, 0x27, 0x3a, 0x8c, 0x42, 0x06, 0xf8, 0xcf, 0xcd,
+    0x2c, 0xc8, 0xfa, 0x44, 0x7a, 0xa9, 0xfc, 0x47, 0x1a, 0x6a, 0xce, 0x5b, 0xe8, 0x5a, 0x26, 0x08,
+    0x8b, 0x2c, 0xe7, 0xa4, 0xee, 0x7f, 0x94, 0x59, 0x9a, 0xfb, 0xd5, 0xfb, 0x68, 0x35, 0xc3, 0x49,
+    0xd0, 0xe5, 0xe7, 0xe1, 0xa2, 0x20, 0xcb, 0x04, 0x53, 0xb5, 0x9d, 0xe4, 0x69, 0x5e, 0x0c, 0x1f,
+    0x8d, 0x91, 0xbf, 0x0f, 0xe4, 0x73, 0x39, 0x5f, 0xe8, 0xcd, 0xb6, 0xb2, 0xc0, 0xf7, 0x18, 0x3b,
+    0xed, 0xd9, 0xf3, 0xe8, 0xb4, 0x67, 0x0f, 0x47, 0x02, 0x39, 0x3e, 0xe2, 0xe4, 0x56, 0x24, 0x31,
+    0x4e, 0x3d, 0x60, 0xd8, 0xa1, 0xa3, 0xf3, 0xf8, 0xc0, 0x99, 0x86, 0x41, 0x43, 0x39, 0x49, 0x23,
+    0xa5, 0x42, 0x07, 0x50, 0x76, 0x78, 0x95, 0xc1, 0xaf, 0x72, 0xce, 0x4e, 0x7b, 0x98, 0xbe, 0x87,
+    0xc8, 0xe4, 0xae, 0xfb, 0x89, 0xce, 0x2a, 0x21, 0x00, 0xc5, 0xc6, 0x1b, 0x23, 0xa0, 0x5c, 0xd5,
+    0xfc, 0xf7, 0xf0, 0x36, 0x45, 0xae, 0x2f, 0xe8, 0x79, 0x96, 0xc4, 0xb1, 0xcc, 0x40, 0xc4, 0x9e,
+    0x2b, 0xa7, 0xf8, 0x2c, 0x74, 0x04, 0x9c, 0xca, 0xaf, 0x0e, 0xb4, 0x84, 0x43, 0xe4, 0x69, 0x8f,
+    0xa9, 0x40, 0xcd, 0xfe, 0x2b, 0xa9, 0x1d, 0xc1, 0x8e, 0x74, 0xd8, 0x93, 0x8e, 0x98, 0x27, 0x59,
+    0xe8, 0x74, 0xe1, 0x49, 0x3c, 0x46, 0xeb, 0xd0, 0xe1, 0xa7, 0x5b, 0x3a, 0x32, 0x43, 0x07, 0x4f,
+    0x48, 0x0e, 0x0b, 0x0c, 0x72, 0x59, 0xf0, 0x80, 0x80, 0xa6, 0x12, 0x70, 0xda, 0xb3, 0x55, 0x11,
+    0x70, 0x77, 0xdc, 0x88, 0x7c, 0x76, 0x35, 0x83, 0x40, 0xa8, 0x29, 0x0e, 0xb0, 0x2e, 0x0f, 0x6e,
+    0x18, 0x09, 0x08, 0xc9, 0xcc, 0x2e, 0x90, 0xcb, 0x39, 0x83, 0x84, 0x70, 0x39, 0xc6, 0xce, 0x7e,
+    0x57, 0xae, 0xb3, 0x1f, 0xb5, 0x9e, 0x58, 0xed, 0x34, 0x38, 0x1d, 0xd2, 0xf9, 0x90, 0xc2, 0xfc,
+    0xfc, 0x1b, 0x55, 0x36, 0xa0, 0x7f, 0x18, 0x1e, 0x1c, 0x10, 0x35, 0x89, 0x9a, 0x14, 0xc9, 0x42,
+    0x9f, 0x75, 0x52, 0xa9, 0xc5, 0x3a, 0xec, 0xfb, 0x1b, 0xfc, 0x15, 0xf8, 0xd3, 0x21, 0x36, 0x1e,
+    0xf1, 0x70, 0x26, 0x65, 0xac, 0x2e, 0xc2, 0x69, 0x94, 0x2a, 0x39, 0x12, 0xfc, 0x5f, 0xaf, 0x27,
+    0x74, 0x94, 0x7d, 0x15, 0x51, 0x16, 0x8b, 0xb9, 0x9c, 0x44, 0xa8, 0x4e, 0x30, 0xf0, 0x55, 0x8a,
+    0x42, 0x4c, 0x8b, 0x1c, 0xcf, 0x33, 0x3c, 0xb2, 0xc7, 0xb9, 0xd0, 0x03, 0xb0, 0x99, 0xd3, 0x34,
+    0x4a, 0x52, 0x15, 0x4d, 0xe5, 0x47, 0x15, 0x0e, 0x8e, 0xc1, 0xde, 0x70, 0x8a, 0xe2, 0x5b, 0x59,
+    0xe8, 0x44, 0xc9, 0x58, 0x8c, 0x37, 0x76, 0x29, 0x85, 0x44, 0x92, 0x89, 0x65, 0xf2, 0x87, 0x08,
+    0xc5, 0x63, 0x0f, 0x0f, 0xc1, 0x17, 0x95, 0x67, 0xc2, 0xed, 0x8b, 0x50, 0xe4, 0xd3, 0xa9, 0xd7,
+    0x01, 0x5f, 0xa5, 0x05, 0x20, 0x1c, 0xa2, 0x28, 0x45, 0xb1, 0x94, 0xe9, 0xe0, 0x46, 0xea, 0xb7,
+    0x50, 0x0e, 0x8f, 0xaf, 0x37, 0xef, 0x63, 0x97, 0xf1, 0xed, 0x8d, 0x2c, 0x25, 0xc3, 0xfb, 0x7e,
+    0x5a, 0x83, 0xfe, 0x8a, 0x1a, 0x0e, 0xba, 0x9f, 0x96, 0xbc, 0x57, 0x53, 0xc2, 0x4f, 0x0f, 0x90,
+    0x12, 0x3c, 0x1a, 0x32, 0x90, 0x7f, 0x1e, 0x12, 0x82, 0xfd, 0x57, 0xd1, 0xdb, 0x78, 0x7f, 0xfb,
+    0xc0, 0x06, 0x65, 0x4a, 0xa8, 0xf7, 0x30, 0xe1, 0xff, 0xd0, 0x9a, 0x32, 0x43, 0x54, 0x6b, 0xe0,
+    0xaa, 0xfb, 0xa9, 0x29, 0x3e, 0x9b, 0x94, 0x08, 0xaa, 0x07, 0x89, 0x29, 0xe8, 0x9a, 0xf4, 0x1c,
+    0x57, 0x0f, 0xae, 0x30, 0x91, 0x87, 0x35, 0xd3, 0x65, 0xc6, 0x27, 0x1a, 0x81, 0x76, 0xbe, 0x70,
+    0x6f, 0xfd, 0xc8, 0x1f, 0x7b, 0xdb, 0x42, 0xea, 0x65, 0x91, 0x89, 0x8f, 0x91, 0x9e, 0x05, 0x08,
+    0x0f, 0x37, 0xf2, 0xcd, 0x63, 0x92, 0xb9, 0x63, 0xff, 0xd6, 0xa3, 0x0a, 0xa3, 0x5a, 0x88, 0xd6,
+    0xe3, 0x92, 0x3c, 0xe9, 0xc6, 0x6b, 0x3f, 0xde, 0x78, 0x5b, 0x76, 0x6b, 0xc0, 0xc9, 0x38, 0xa8,
+    0x8e, 0x99, 0xf0, 0x9a, 0x1f, 0x71, 0x4c, 0x4a, 0xf7, 0xf1, 0x36, 0x5e, 0xef, 0x16, 0x6b, 0x1f,
+    0x9f, 0x1b, 0x7c, 0x7a, 0xd7, 0x4d, 0x6e, 0xcb, 0x45, 0x0c, 0x9a, 0x4b, 0xf6, 0x8a, 0x2b, 0xd7,
+    0x58, 0x15, 0x3a, 0x0e, 0x31, 0xa5, 0x81, 0x40, 0x63, 0xe4, 0x8d, 0x6d, 0x63, 0xae, 0xd7, 0xe1,
+    0xe3, 0xed, 0x7a, 0x27, 0x36, 0xf8, 0xd8, 0xec, 0xae, 0xc5, 0xef, 0x85, 0x6b, 0xc2, 0xe6, 0xfc,
+    0x5a, 0x14, 0x18, 0x2b, 0x76, 0xd7, 0x43, 0x2c, 0xc5, 0xf8, 0xb5, 0xd0, 0x78, 0xd7, 0x86, 0x86,
+    0x79, 0x9e, 0xbb, 0xce, 0x3f, 0x33, 0xe7, 0xf7, 0xfc, 0xec, 0x11, 0x15, 0x44, 0xb0, 0xd8, 0xa2,
+    0x58, 0x7d, 0x00, 0x5c, 0x1c, 0xca, 0x9e, 0x89, 0x52, 0xa9, 0xc2, 0x6c, 0x99, 0xa6, 0x0d, 0x23,
+    0xa2, 0x8a, 0x87, 0x9b, 0xaf, 0x88, 0x48, 0xea, 0x62, 0xe3, 0x52, 0x00, 0x79, 0x5b, 0x26, 0x8e,
+    0x47, 0x02, 0x23, 0x5b, 0x11, 0x87, 0x7f, 0xbe, 0xfc, 0xcb, 0xa7, 0x60, 0x41, 0x3d, 0x9b, 0x99,
+    0x1f, 0x89, 0xdd, 0x24, 0xd2, 0x93, 0x99, 0x2b, 0x8b, 0xc2, 0xdb, 0x0a, 0x63, 0x7b, 0x0c, 0x76,
+    0x78, 0xb3, 0x80, 0xb3, 0xc9, 0x27, 0xea, 0xe5, 0x62, 0x1c, 0x8c, 0xe7, 0x94, 0x56, 0xc4, 0x54,
+    0x39, 0x43, 0xce, 0x2f, 0x23, 0x4b, 0xd4, 0x32, 0x0c, 0x8a, 0x3d, 0xf1, 0x01, 0x1a, 0xc7, 0x41,
+    0xba, 0x13, 0x17, 0xfc, 0x50, 0xec, 0x04, 0xb2, 0x45, 0x01, 0x75, 0xec, 0x8c, 0xae, 0xa6, 0x74,
+    0x61, 0x0c, 0x63, 0xb8, 0x0b, 0xf1, 0xee, 0xd5, 0xfb, 0x0f, 0x97, 0xaf, 0xde, 0xbd, 0x75, 0x8c,
+    0xf5, 0x3a, 0xd7, 0xff, 0xc4, 0x79, 0x9d, 0x2f, 0x04, 0xd1, 0xce, 0x7e, 0xd9, 0x89, 0x3f, 0xfd,
+    0xe2, 0x8b, 0x55, 0x5e, 0xc0, 0x56, 0x8f, 0xb7, 0x58, 0x04, 0x78, 0xfc, 0xa0, 0x7a, 0xc8, 0x5c,
+    0x7d, 0x2f, 0xd0, 0xf9, 0xbb, 0x64, 0x2d, 0x63, 0x77, 0xe0, 0xed, 0xc4, 0x5c, 0x59, 0xae, 0xf9,
+    0x6d, 0x71, 0x7e, 0xed, 0xf3, 0x72, 0x3c, 0xee, 0x44, 0x8e, 0xd4, 0x83, 0xd6, 0x45, 0x95, 0xde,
+    0x01, 0x89, 0x4a, 0x21, 0xaa, 0xcc, 0x6e, 0xf4, 0xec, 0x1c, 0xbb, 0xd9, 0x58, 0xe1, 0x15, 0x34,
+    0xf3, 0x25, 0x07, 0xec, 0x1c, 0xe1, 0x78, 0xc6, 0xa1, 0xa3, 0x4e, 0x03, 0x2e, 0xac, 0x3d, 0x14,
+    0xcf, 0x50, 0x58, 0xb9, 0xb0, 0x74, 0x32, 0x85, 0x87, 0x95, 0xf8, 0xf6, 0x4d, 0x1c, 0xad, 0x92,
+    0x0c, 0x55, 0x72, 0xf0, 0xf6, 0x16, 0x36, 0xb9, 0xcc, 0x97, 0xc5, 0x44, 0x7a, 0xa5, 0x6d, 0x3b,
+    0xe4, 0x39, 0xb9, 0x12, 0x8d, 0x39, 0xd7, 0xe9, 0x49, 0x7a, 0xe3, 0x10, 0x95, 0x2a, 0xc8, 0xb3,
+    0xb9, 0x54, 0x2a, 0xba, 0x91, 0xa1, 0x2b, 0xbd, 0xf0, 0x6c, 0xdf, 0xb1, 0x32, 0x00, 0x4c, 0xa3,
+    0x92, 0x14, 0x0a, 0xe1, 0xd4, 0x75, 0x41, 0xb7, 0x15, 0x77, 0xfd, 0x61, 0x40, 0x43, 0xcb, 0xb0,
+    0xff, 0xc4, 0xc8, 0x8a, 0x5a, 0x38, 0x08, 0x02, 0x07, 0x5e, 0xbe, 0xab, 0xce, 0x25, 0x2a, 0xb6,
+    0x5a, 0x17, 0x20, 0x02, 0x7b, 0x4c, 0xd2, 0x1c, 0x70, 0x01, 0x54, 0x4a, 0xcc, 0x01, 0x1e, 0x3b,
+    0xc6, 0xd5, 0xca, 0x0c, 0xf8, 0x2b, 0xf5, 0x97, 0x85, 0xcc, 0xec, 0x91, 0x51, 0x73, 0x5c, 0xa9,
+    0x86, 0x75, 0x18, 0x80, 0x2b, 0xa3, 0xfb, 0x3f, 0xe4, 0xf8, 0x12, 0x95, 0x9e, 0xd4, 0xee, 0xf5,
+    0x4a, 0x0d, 0x7b, 0xbd, 0xc7, 0x5b, 0x14, 0x7e, 0x11, 0xad, 0x09, 0x66, 0xb9, 0xd2, 0xbb, 0xde,
+    0x4a, 0x5d, 0x37, 0xa0, 0xe9, 0x6d, 0xcb, 0x9d, 0x46, 0x7b, 0x46, 0x1f, 0x35, 0x10, 0xbb, 0x52,
+    0xc1, 0x38, 0xc9, 0xa2, 0x62, 0x73, 0xc5, 0x07, 0x6d, 0x54, 0x14, 0xd1, 0x66, 0xbc, 0x9c, 0x4e,
+    0x71, 0xf8, 0x8f, 0x68, 0x12, 0x45, 0x1f, 0x09, 0xc9, 0x96, 0xea, 0x58, 0x89, 0x75, 0xb1, 0x84,
+    0xc0, 0xa4, 0xec, 0x4a, 0x5d, 0xc2, 0xcc, 0x2e, 0x49, 0xf7, 0x43, 0x92, 0xe9, 0x17, 0xaf, 0x68,
+    0xb9, 0xfb, 0xd3, 0x33, 0x7f, 0xf0, 0xb3, 0xe7, 0x79, 0x4d, 0xe3, 0xd8, 0x63, 0xac, 0x36, 0x6c,
+    0xa4, 0x04, 0x99, 0x1c, 0x47, 0x21, 0x02, 0x45, 0x75, 0x5a, 0x59, 0xc4, 0x59, 0x29, 0x61, 0xcd,
+    0x2e, 0x63, 0xc6, 0x8f, 0x95, 0x85, 0x8d, 0x6a, 0xdd, 0xd6, 0x32, 0xdf, 0xfd, 0xaa, 0x22, 0xd9,
+    0x5d, 0x25, 0x73, 0x89, 0x08, 0x73, 0x2b, 0xcb, 0xfa, 0xc7, 0x04, 0x7e, 0x76, 0xe5, 0x6a, 0x0f,
+    0x0d, 0xe5, 0x50, 0x0b, 0x4b, 0xc6, 0xb3, 0x54, 0x8a, 0xe4, 0x53, 0x61, 0x80, 0x14, 0x86, 0x54,
+    0x49, 0x14, 0x40, 0x85, 0xc3, 0x19, 0xe0, 0x30, 0xd8, 0x1a, 0x86, 0x36, 0xc9, 0x2a, 0x66, 0x4f,
+    0xd2, 0x79, 0xfd, 0xf7, 0x44, 0xae, 0x6a, 0x50, 0x12, 0xff, 0x38, 0x18, 0x6f, 0xb4, 0xfc, 0xc0,
+    0x51, 0x75, 0xfa, 0x9c, 0x22, 0x22, 0xa6, 0x6c, 0xc6, 0x86, 0x75, 0xfb, 0xde, 0x51, 0x18, 0xf6,
+    0xd7, 0x2f, 0xfa, 0x75, 0x48, 0x98, 0x35, 0x15, 0xc5, 0xc0, 0x83, 0x4c, 0x03, 0x4f, 0xc4, 0x05,
+    0xfa, 0x9a, 0x57, 0xc0, 0x49, 0x0c, 0xf5, 0xdb, 0x76, 0xbd, 0x36, 0x99, 0x04, 0x4b, 0xde, 0xd3,
+    0x8a, 0xa7, 0x5e, 0x99, 0x51, 0xca, 0x91, 0x67, 0x9e, 0xc9, 0x2c, 0x4d, 0xbe, 0x27, 0xde, 0x93,
+    0x81, 0x87, 0x34, 0xd3, 0xca, 0x32, 0xc6, 0x27, 0xbb, 0x26, 0x6a, 0x19, 0x09, 0xa4, 0x81, 0xb2,
+    0x91, 0x70, 0x64, 0x3c, 0x64, 0x42, 0x9b, 0x23, 0x1c, 0x96, 0x2d, 0x50, 0x58, 0x6e, 0x48, 0x1c,
+    0x79, 0xc4, 0xd2, 0xda, 0x73, 0xcb, 0x06, 0x81, 0x85, 0x7b, 0xa0, 0x6a, 0x5e, 0xa5, 0x0d, 0x05,
+    0xa3, 0xae, 0x89, 0xee, 0xd6, 0x52, 0x8e, 0xae, 0x46, 0xe8, 0x34, 0x02, 0x4a, 0xa6, 0xae, 0x8e,
+    0x6e, 0xfc, 0x49, 0xaa, 0x7c, 0x42, 0x1c, 0xa4, 0x33, 0xbe, 0x90, 0xf5, 0xa1, 0x31, 0x81, 0x58,
+    0x5a, 0xda, 0x73, 0x83, 0xa8, 0xad, 0x4b, 0xb0, 0xc6, 0x83, 0xc3, 0xeb, 0x84, 0x8e, 0x01, 0x33,
+    0x43, 0x9c, 0xa0, 0x01, 0x7a, 0x3b, 0x39, 0x45, 0x9b, 0x1e, 0x13, 0x59, 0x33, 0x85, 0xd0, 0xf3,
+    0xa8, 0x63, 0x45, 0x94, 0x2d, 0x53, 0xa1, 0xb1, 0x7e, 0xcd, 0x05, 0x89, 0x3b, 0xae, 0x64, 0x19,
+    0xeb, 0x2c, 0x84, 0x9c, 0xb6, 0x52, 0x71, 0x7c, 0x87, 0xda, 0x63, 0xc7, 0x1f, 0x07, 0xdc, 0x0a,
+    0x40, 0x1a, 0x10, 0x04, 0x58, 0xc8, 0xf9, 0xef, 0x43, 0x82, 0x52, 0x17, 0xa0, 0x75, 0x9d, 0x49,
+    0x4a, 0x05, 0x99, 0xef, 0x56, 0x18, 0x3d, 0xba, 0x27, 0x22, 0x9f, 0x82, 0x55, 0x12, 0x53, 0x50,
+    0x76, 0xa6, 0x92, 0x0c, 0x78, 0xdd, 0x03, 0xc7, 0x73, 0xd4, 0xba, 0x8f, 0xb7, 0x34, 0xb3, 0x7b,
+    0xf2, 0x2f, 0x3c, 0x01, 0x97, 0x32, 0xc8, 0xf2, 0x95, 0x0b, 0x18, 0xf8, 0x62, 0x3b, 0x89, 0x26,
+    0x33, 0x39, 0x74, 0xb2, 0xbc, 0xab, 0x74, 0x5e, 0x48, 0x67, 0xe7, 0x05, 0xc6, 0xfa, 0x26, 0x52,
+    0xf6, 0xd1, 0xe5, 0x80, 0x23, 0x57, 0xcf, 0x40, 0x10, 0xf1, 0x24, 0x8c, 0x90, 0xe4, 0x65, 0x7d,
+    0x16, 0xd0, 0x5d, 0x50, 0x16, 0xbf, 0x99, 0x25, 0x29, 0x9c, 0xab, 0xb3, 0x7b, 0xe7, 0xf6, 0xdc,
+    0x72, 0x05, 0x53, 0x7e, 0xca, 0x63, 0xc9, 0x27, 0x8a, 0xb7, 0x6f, 0xca, 0x4b, 0x3e, 0x7b, 0x5c,
+    0x55, 0x99, 0x12, 0x87, 0x2c, 0x9b, 0x12, 0xa5, 0x3b, 0xec, 0x48, 0x67, 0x2f, 0x8e, 0xa4, 0x56,
+    0xbd, 0x45, 0xdd, 0x66, 0x83, 0xa4, 0x6e, 0x77, 0x40, 0x41, 0x73, 0x2d, 0x61, 0x5a, 0x74, 0xa6,
+    0x08, 0xf3, 0x95, 0x75, 0x4b, 0xc5, 0xf1, 0x16, 0x95, 0x24, 0x11, 0x52, 0x77, 0x03, 0x4a, 0x6c,
+    0x88, 0x1e, 0x88, 0xe8, 0xb8, 0x3f, 0xa9, 0xc9, 0xfe, 0x81, 0x8e, 0xb6, 0xbd, 0xb3, 0xe9, 0x95,
+    0x40, 0xc1, 0x73, 0xad, 0x9d, 0xc1, 0xf4, 0x90, 0x40, 0x4c, 0x58, 0xb1, 0x44, 0xeb, 0xc4, 0x0c,
+    0xb9, 0x85, 0x32, 0x2c, 0xc5, 0xf2, 0x32, 0xe5, 0xac, 0x89, 0xb1, 0xa0, 0xd9, 0x3f, 0x8d, 0x88,
+    0x9a, 0x4a, 0xc2, 0x50, 0xd1, 0xbf, 0xf6, 0x15, 0xbd, 0x94, 0xa2, 0x7f, 0xcd, 0x2b, 0x37, 0x51,
+    0x8a, 0x3f, 0xcc, 0x80, 0xe9, 0xb0, 0xac, 0x26, 0x86, 0xe7, 0x5d, 0x1c, 0xda, 0xdd, 0x0d, 0x0e,
+    0xad, 0xae, 0x21, 0x17, 0x4c, 0x48, 0x2b, 0x6e, 0xc5, 0xc6, 0x1f, 0xf4, 0xbd, 0x6f, 0xdf, 0xd0,
+    0x31, 0x41, 0xb5, 0x56, 0xb4, 0xdc, 0x96, 0xea, 0xcc, 0xdb, 0xf9, 0x91, 0x5e, 0x18, 0xc1, 0xaf,
+    0xf9, 0x48, 0x42, 0x7e, 0x82, 0x5a, 0x73, 0xa4, 0x87, 0x32, 0x2b, 0xfa, 0xc7, 0x48, 0x10, 0x8d,
+    0x81, 0x01, 0x6c, 0x4e, 0xc8, 0x33, 0x63, 0xd8, 0x7c, 0xf0, 0xdc, 0x3d, 0xf6, 0x6f, 0x7d, 0x4a,
+    0x1e, 0x36, 0xa6, 0xcb, 0x10, 0x99, 0x07, 0xe6, 0x9c, 0x6b, 0x84, 0x04, 0xfc, 0x66, 0x42, 0x42,
+    0x71, 0x48, 0xdc, 0xe2, 0xe9, 0xf6, 0xff, 0x18, 0x19, 0xf4, 0x07, 0xec, 0xb5, 0x3c, 0x47, 0xae,
+    0x3c, 0x30, 0x0c, 0xf3, 0x60, 0xb4, 0x6a, 0x49, 0x5a, 0x73, 0xa0, 0x6d, 0x23, 0xde, 0x9c, 0x34,
+    0x3f, 0x24, 0xee, 0x32, 0x01, 0xe2, 0xeb, 0xf8, 0x69, 0x95, 0x2f, 0xf0, 0x74, 0xcd, 0x6e, 0x6f,
+    0xa6, 0x83, 0x95, 0x81, 0x5d, 0xf7, 0xed, 0xdb, 0x4f, 0x3f, 0x7b, 0x01, 0xaa, 0xfd, 0xb7, 0xd0,
+    0xc7, 0xad, 0xf2, 0x92, 0x67, 0x88, 0x2c, 0x8b, 0x3b, 0x44, 0x26, 0xe2, 0x4a, 0x6b, 0xd6, 0x22,
+    0x4c, 0x48, 0x62, 0xc8, 0x67, 0x0b, 0x43, 0x4f, 0x1c, 0x8e, 0xee, 0x1a, 0xfe, 0x7c, 0x27, 0x84,
+    0xcf, 0x4f, 0x79, 0x49, 0x0a, 0xf5, 0x6e, 0x08, 0x54, 0x05, 0x1d, 0xfb, 0xe5, 0x0e, 0xb5, 0x2a,
+    0x77, 0x76, 0x38, 0x6c, 0xb4, 0x83, 0x3b, 0x94, 0x35, 0xea, 0x81, 0x1d, 0xa0, 0xab, 0xb6, 0x17,
+    0x1a, 0xad, 0x94, 0x8e, 0xd2, 0x30, 0x6c, 0xcc, 0x8d, 0xa8, 0xe1, 0xb5, 0xf1, 0xa0, 0x47, 0xdc,
+    0xd3, 0xb6, 0x53, 0x3e, 0x1d, 0x42, 0x96, 0x5f, 0xdd, 0xc4, 0xb7, 0x0f, 0x89, 0x46, 0x73, 0xdf,
+    0xa2, 0xaa, 0x04, 0x99, 0x23, 0xd1, 0xb5, 0x97, 0x00, 0xc7, 0x1f, 0x29, 0xfb, 0xd9, 0xc9, 0x36,
+    0x1c, 0xca, 0x49, 0x9e, 0xd9, 0x76, 0xec, 0x2d, 0x04, 0xbf, 0x52, 0x85, 0x42, 0xf7, 0x0f, 0x0e,
+    0x9d, 0xbc, 0xe5, 0x80, 0xbd, 0x87, 0x70, 0x18, 0x86, 0xd4, 0x85, 0x06, 0xe6, 0x6a, 0x2a, 0x3c,
+    0x32, 0x4b, 0x79, 0x98, 0xb3, 0x5c, 0x4b, 0xb5, 0x36, 0x43, 0x4f, 0x9c, 0x0b, 0xe7, 0x82, 0x6e,
+    0xf7, 0x04, 0x7f, 0xc9, 0xe0, 0x88, 0x21, 0xde, 0xf9, 0x26, 0xc3, 0x21, 0xe9, 0x4c, 0x28, 0x9b,
+    0x6b, 0x89, 0xfb, 0x1b, 0x33, 0x33, 0xef, 0x54, 0x3e, 0xa0, 0x37, 0xaf, 0xc6, 0x77, 0xa3, 0xe7,
+    0x32, 0x73, 0x4d, 0x81, 0xc8, 0x73, 0x12, 0xc7, 0xbe, 0x30, 0x91, 0xeb, 0xf4, 0xec, 0xd5, 0x87,
+    0xe3, 0x1f, 0x0a, 0x4d, 0x3d, 0x93, 0x99, 0x5b, 0xa0, 0x25, 0x60, 0x1a, 0xd7, 0x2b, 0x47, 0xec,
+    0x56, 0xcd, 0xd8, 0x6d, 0x1f, 0x68, 0xe5, 0x85, 0x0a, 0xf9, 0xc9, 0xe2, 0x85, 0x0a, 0x78, 0x55,
+    0x68, 0x4d, 0x37, 0x40, 0x1a, 0x10, 0x28, 0xc2, 0xbe, 0xbd, 0xee, 0xb1, 0x57, 0x3e, 0x6a, 0x9e,
+    0xe7, 0x60, 0x1f, 0x8b, 0x8b, 0xab, 0x2b, 0xbe, 0xfa, 0x49, 0xb4, 0x12, 0xfc, 0x85, 0x15, 0x3b,
+    0xcc, 0xbd, 0x78, 0xf7, 0x46, 0x3c, 0x3f, 0x7e, 0xf9, 0xc2, 0x63, 0x56, 0x49, 0xf6, 0x2e, 0x25,
+    0x43, 0x9a, 0x32, 0xd6, 0x2f, 0x5f, 0x5f, 0x59, 0xfe, 0x97, 0xe8, 0xf0, 0x53, 0x59, 0xb6, 0x08,
+    0xb4, 0x80, 0x50, 0x8e, 0xa2, 0xd3, 0xd2, 0xd3, 0x15, 0x2c, 0x55, 0xb7, 0x85, 0x6d, 0x6b, 0x89,
+    0x02, 0xb5, 0x8a, 0x46, 0x82, 0xd3, 0x3f, 0x86, 0x2f, 0x5f, 0xbe, 0xf4, 0xcb, 0xb7, 0xcf, 0xad,
+    0xb7, 0x8b, 0xd6, 0xdb, 0x15, 0xbd, 0xb5, 0x16, 0xc7, 0xc0, 0x67, 0xbf, 0x51, 0x42, 0x65, 0xb9,
+    0x96, 0x17, 0x5a, 0xbb, 0xf3, 0xaa, 0xb6, 0x23, 0x1b, 0x20, 0x40, 0xd8, 0x14, 0x73, 0x85, 0x22,
+    0xcd, 0x18, 0x63, 0xae, 0x7a, 0xc7, 0xcd, 0xaa, 0xb7, 0xb4, 0x51, 0xf0, 0xfd, 0xc9, 0x77, 0xe6,
+    0x19, 0xc5, 0x41, 0x3f, 0x38, 0x3e, 0xf9, 0x8e, 0xaf, 0x27, 0xa2, 0xb1, 0x72, 0x89, 0x45, 0x17,
+    0x8c, 0x91, 0x02, 0xd9, 0xae, 0xc1, 0x0b, 0xd0, 0xd2, 0x23, 0x53, 0x0e, 0x40, 0x0a, 0xfe, 0xad,
+    0x14, 0xa8, 0xf3, 0x8f, 0xca, 0xad, 0x0b, 0x40, 0xa6, 0x3d, 0xb7, 0xd7, 0x21, 0x76, 0xe1, 0x33,
+    0xbb, 0x9b, 0x2f, 0xd0, 0xe7, 0xfa, 0x82, 0xeb, 0x7d, 0xa0, 0xf4, 0x84, 0xee, 0xd3, 0x1a, 0xac,
+    0x70, 0x0a, 0xfe, 0x31, 0x5a, 0xb4, 0xb8, 0x19, 0x36, 0x2c, 0x1d, 0x5f, 0xdd, 0x33, 0x47, 0x8f,
+    0x58, 0xe0, 0xef, 0x84, 0xbb, 0x86, 0x7a, 0x3d, 0x32, 0x7a, 0xa1, 0xc7, 0x28, 0x52, 0x98, 0x85,
+    0xb1, 0x4c, 0x1d, 0xd4, 0x55, 0x75, 0x4b, 0xbd, 0x76, 0x55, 0x0c, 0xde, 0xd9, 0xc0, 0xad, 0x57,
+    0x88, 0x6e, 0xa9, 0x9d, 0xd7, 0x3b, 0xc6, 0xa6, 0x27, 0x7d, 0x56, 0xa0, 0xdf, 0x0e, 0xfa, 0x66,
+    0x85, 0x6f, 0x37, 0x2d, 0x81, 0xd3, 0xee, 0x0e, 0x2a, 0x04, 0x79, 0x95, 0x07, 0x17, 0xb2, 0xa0,
+    0xdb, 0x1d, 0xfa, 0x42, 0xce, 0x9c, 0x67, 0xd8, 0xb2, 0x46, 0x1d, 0x17, 0x0d, 0x4d, 0x44, 0x1a,
+    0x3e, 0x16, 0x74, 0xc8, 0x45, 0x88, 0xad, 0x78, 0x99, 0x52, 0x5f, 0xdb, 0xca, 0x42, 0xd5, 0xb0,
+    0x11, 0xa7, 0x82, 0x65, 0x2d, 0x8e, 0xc9, 0x09, 0xd8, 0x31, 0xbc, 0x23, 0x81, 0x41, 0xde, 0x2a,
+    0x4a, 0x74, 0x58, 0xc3, 0x0f, 0x3e, 0xac, 0x9d, 0x03, 0x19, 0x41, 0x69, 0x64, 0xa9, 0x35, 0xe5,
+    0x15, 0xd5, 0x85, 0x17, 0xbd, 0xf9, 0x0d, 0x55, 0xc0, 0xc0, 0x9a, 0xd2, 0xac, 0xc6, 0x36, 0x75,
+    0xb4, 0x34, 0x9a, 0x42, 0xd3, 0x4c, 0xee, 0x05, 0x92, 0x68, 0x6b, 0x8d, 0x87, 0x3f, 0x90, 0xcd,
+    0x3f, 0xb1, 0xb8, 0x62, 0xe7, 0xd7, 0xf7, 0x6c, 0x7d, 0x9f, 0x36, 0xf6, 0xf6, 0xb3, 0x72, 0x63,
+    0x41, 0x85, 0x11, 0x63, 0xd1, 0xaa, 0x4e, 0xbd, 0xc7, 0x16, 0xf6, 0x82, 0x12, 0xcd, 0x86, 0x08,
+    0x85, 0xbb, 0x46, 0xd2, 0xad, 0x02, 0x5a, 0x3c, 0x79, 0x22, 0x36, 0x8d, 0x81, 0xcf, 0x34, 0x50,
+    0x34, 0x06, 0x2e, 0x68, 0x40, 0x37, 0x06, 0xae, 0x6c, 0x76, 0x65, 0x76, 0x98, 0x3b, 0xaa, 0x84,
+    0x01, 0xe0, 0x5b, 0xa9, 0xa4, 0x11, 0xb4, 0xad, 0x74, 0x06, 0xdc, 0xcc, 0x40, 0x24, 0xa8, 0x12,
+    0xd3, 0x38, 0x45, 0xa3, 0x4d, 0x59, 0x78, 0x2a, 0x6a, 0xec, 0x4b, 0x19, 0xfb, 0xa5, 0x6c, 0xfd,
+    0x52, 0xa6, 0xbe, 0xd7, 0xf6, 0x17, 0x8d, 0x43, 0xc5, 0x16, 0xdc, 0xc4, 0x59, 0x05, 0xf7, 0xbd,
+    0x4c, 0x68, 0xaf, 0x0b, 0xd0, 0xee, 0x6b, 0x03, 0x70, 0xd7, 0xee, 0x47, 0x4a, 0x90, 0x36, 0x1e,
+    0x3d, 0xd5, 0xcc, 0x71, 0xc4, 0x19, 0xe6, 0x0d, 0x04, 0x9d, 0x36, 0x10, 0xe4, 0xc1, 0xec, 0xa5,
+    0xbe, 0xe6, 0xfa, 0xa2, 0x09, 0xe5, 0x12, 0xa4, 0x9c, 0xaf, 0x6c, 0xce, 0xad, 0x42, 0x6a, 0xd4,
+    0xd9, 0x33, 0x54, 0x25, 0xa9, 0xe9, 0x48, 0x1b, 0x39, 0x9b, 0x40, 0xda, 0x4c, 0xa1, 0x0c, 0xda,
+    0x3a, 0x1f, 0xaf, 0xab, 0x49, 0xa4, 0xe3, 0x4d, 0xfd, 0x72, 0x11, 0x16, 0xf5, 0xcb, 0x15, 0xea,
+    0x88, 0xfd, 0xbb, 0x95, 0xf7, 0x75, 0x23, 0x37, 0xf0, 0xd7, 0xfe, 0xc6, 0xd7, 0x7e, 0xc1, 0x17,
+    0x2c, 0xed, 0xe8, 0x02, 0xec, 0x48, 0x8a, 0x5a, 0xa0, 0x51, 0x55, 0xd9, 0x72, 0xca, 0x38, 0x37,
+    0xf7, 0xaf, 0x4f, 0xcc, 0xfd, 0xeb, 0x13, 0x73, 0xe5, 0xfa, 0xc4, 0xdc, 0xb4, 0xde, 0xad, 0x72,
+    0x0f, 0x9c, 0xa4, 0x1d, 0x73, 0x70, 0x9a, 0x90, 0x69, 0x3a, 0xf7, 0x15, 0x81, 0xce, 0x6c, 0xbf,
+    0x77, 0x01, 0x21, 0x68, 0x55, 0xa3, 0x36, 0xee, 0xb4, 0x97, 0x1d, 0xd5, 0xcb, 0xaa, 0xc4, 0xb5,
+    0x07, 0x84, 0xd6, 0x79, 0x36, 0xaa, 0x50, 0x29, 0x62, 0x99, 0x62, 0x1f, 0xd4, 0x71, 0x43, 0x8e,
+    0x37, 0xfe, 0x4e, 0x84, 0x6e, 0xab, 0x61, 0x88, 0xe8, 0x26, 0x4a, 0xb2, 0xb6, 0xbf, 0xdb, 0xa9,
+    0xab, 0x1d, 0xae, 0x55, 0x50, 0x94, 0xf9, 0xcb, 0x5d, 0xd3, 0x65, 0x0b, 0x81, 0x6a, 0x53, 0x3e,
+    0x14, 0xf4, 0xc0, 0xa0, 0x3b, 0x94, 0x41, 0x1b, 0xa8, 0x3b, 0x0b, 0xdb, 0xa7, 0xc2, 0x5e, 0xfa,
+    0xb0, 0x8d, 0x48, 0x23, 0x01, 0x55, 0xd4, 0x94, 0xee, 0x59, 0xb0, 0x86, 0x3c, 0x26, 0x37, 0x16,
+    0xd1, 0xea, 0x47, 0x2a, 0x08, 0xa2, 0xd5, 0x67, 0x7c, 0xc4, 0x45, 0x74, 0x73, 0x53, 0xd7, 0x00,
+    0x7c, 0x81, 0xf6, 0xb7, 0xa5, 0x5c, 0xca, 0xd8, 0x8e, 0x50, 0xae, 0xe7, 0x52, 0x9f, 0xd6, 0x7e,
+    0xc9, 0x37, 0x17, 0x72, 0xa2, 0x6d, 0x5e, 0x63, 0xeb, 0xb1, 0x63, 0x63, 0x9a, 0xe1, 0x9b, 0x7f,
+    0x71, 0x23, 0x73, 0xbe, 0xb6, 0xf2, 0xe1, 0xba, 0x1c, 0x75, 0x74, 0x2c, 0xb8, 0xd1, 0xa0, 0xaf,
+    0xfa, 0x7b, 0x6a, 0x42, 0x5f, 0xb8, 0xd6, 0xb6, 0xc2, 0xa2, 0x3f, 0x5a, 0xf2, 0xea, 0xf0, 0xb1,
+    0x5b, 0x78, 0xd5, 0x5e, 0xf8, 0xa4, 0x72, 0xef, 0x35, 0x1d, 0x6f, 0x10, 0xf4, 0x4d, 0x9a, 0x10,
+    0xca, 0xed, 0xbd, 0x8c, 0x3d, 0x06, 0x2d, 0x2d, 0xe9, 0x6b, 0xef, 0x7d, 0xef, 0xb6, 0x95, 0x46,
+    0x06, 0xdb, 0x57, 0xee, 0x69, 0x42, 0x3e, 0xbc, 0x77, 0xa1, 0x91, 0xfa, 0x9e, 0x85, 0xfe, 0x76,
+    0x11, 0x29, 0x05, 0x7f, 0x0c, 0xc9, 0x19, 0xbb, 0xe6, 0x55, 0xd1, 0xbf, 0xc9, 0x8c, 0xef, 0xc8,
+    0xa0, 0xa5, 0x72, 0x0d, 0xeb, 0xd6, 0x10, 0x6d, 0x9a, 0xdc, 0x64, 0x93, 0x42, 0x62, 0xa9, 0xd2,
+    0xaf, 0xb2, 0x64, 0xce, 0x75, 0x9e, 0xe1, 0xc1, 0x6d, 0x31, 0x3f, 0xb6, 0x01, 0x57, 0x8f, 0xd3,
+    0x36, 0x77, 0x1c, 0x68, 0xbf, 0x51, 0x8c, 0xe9, 0xab, 0xc6, 0x2c, 0xde, 0x50, 0x25, 0xc6, 0x77,
+    0x7d, 0xd6, 0xef, 0xf5, 0x4d, 0x47, 0xd8, 0xf2, 0x46, 0xd5, 0x43, 0xa3, 0xa3, 0x2f, 0x02, 0xfe,
+    0xa6, 0xbf, 0x77, 0x0c, 0x70, 0x3e, 0x3d, 0x19, 0x75, 0x88, 0x99, 0x29, 0x3c, 0x08, 0x4b, 0x54,
+    0x66, 0x04, 0xf4, 0x7b, 0x03, 0x7e, 0xb0, 0x94, 0x7e, 0x17, 0x0b, 0x7d, 0xfc, 0x79, 0x44, 0xbe,
+    0xa9, 0xc9, 0x3f, 0x33, 0x15, 0x25, 0x5f, 0xfa, 0x34, 0x3f, 0x79, 0x68, 0x93, 0xaf, 0xc3, 0x66,
+    0x39, 0x83, 0xbd, 0x7a, 0x34, 0xfe, 0xdd, 0x80, 0x0b, 0x97, 0x4d, 0x6b, 0xb2, 0x0b, 0xd6, 0xcd,
+    0x59, 0x52, 0xac, 0x2a, 0x05, 0xd7, 0x1e, 0x92, 0xf6, 0x33, 0x8f, 0xbe, 0x63, 0xdd, 0x9b, 0xd9,
+    0xd8, 0x19, 0x36, 0xc6, 0xae, 0x53, 0x7d, 0x83, 0x85, 0xbd, 0xc8, 0x44, 0xfb, 0x57, 0x51, 0x14,
+    0x01, 0xa4, 0x46, 0x19, 0x08, 0x7b, 0x27, 0x78, 0xbb, 0xa1, 0x4e, 0x65, 0x84, 0x26, 0x63, 0x35,
+    0xdb, 0xc0, 0xb0, 0xed, 0xd8, 0x22, 0xcd, 0x50, 0x30, 0xf2, 0xa6, 0xcc, 0x0b, 0x44, 0x77, 0x99,
+    0x35, 0x41, 0x43, 0xac, 0x09, 0xfd, 0x77, 0x21, 0xb9, 0xc8, 0x13, 0xfa, 0xdd, 0x1c, 0xf0, 0x8a,
+    0x2e, 0xc5, 0xde, 0x2a, 0x57, 0xbb, 0x19, 0x10, 0xd1, 0x42, 0x68, 0xf6, 0x57, 0x43, 0xf9, 0x26,
+    0x5a, 0x00, 0x6d, 0xd2, 0x95, 0x81, 0x5d, 0xfa, 0x9e, 0x2f, 0x0f, 0x28, 0x15, 0xd0, 0x8d, 0x24,
+    0x85, 0xd4, 0x8f, 0x23, 0xc1, 0x39, 0xa1, 0x7c, 0xff, 0xcc, 0x3c, 0xf6, 0xc3, 0x9d, 0x12, 0xe3,
+    0x22, 0xba, 0x91, 0x00, 0xc6, 0x46, 0xcc, 0xa2, 0x5b, 0x3c, 0xe4, 0xb7, 0x08, 0x72, 0x95, 0x20,
+    0x85, 0xd9, 0xb4, 0x49, 0x57, 0xd3, 0x10, 0x66, 0x5f, 0x17, 0x6f, 0xf4, 0xb0, 0x36, 0xc4, 0xa8,
+    0xd2, 0x26, 0x99, 0xba, 0x47, 0x15, 0x46, 0xab, 0x58, 0xf9, 0x35, 0x81, 0xff, 0xcb, 0x1d, 0x97,
+    0x0b, 0x13, 0xd5, 0xa5, 0xdb, 0x1c, 0xfb, 0x60, 0xba, 0xb3, 0x07, 0x97, 0x4e, 0x28, 0x65, 0xa7,
+    0x7b, 0xcb, 0xed, 0xa0, 0x67, 0x1a, 0xe2, 0x5f, 0xbb, 0xda, 0x2a, 0xea, 0x4b, 0x2d, 0xa2, 0x6e,
+    0x5f, 0x6a, 0xb5, 0x00, 0x5b, 0x58, 0xc0, 0x52, 0x7f, 0x78, 0x40, 0xc7, 0x7d, 0xf8, 0xa1, 0x7b,
+    0xa6, 0x54, 0x50, 0x31, 0x25, 0xd8, 0x15, 0x15, 0xec, 0x1c, 0xfb, 0x33, 0x81, 0x4a, 0xd7, 0x5f,
+    0x07, 0xe1, 0x61, 0x65, 0x1a, 0x46, 0xac, 0x37, 0xbe, 0x57, 0xf5, 0x3d, 0xbb, 0xb5, 0x56, 0xd0,
+    0x55, 0xc8, 0xaf, 0x18, 0x4b, 0xd7, 0xc6, 0xaa, 0x2e, 0x4e, 0x2a, 0x63, 0x1d, 0xb8, 0x3d, 0xb1,
+    0xba, 0x9a, 0x8b, 0x1a, 0xe7, 0x90, 0xd5, 0xda, 0xdd, 0x39, 0x7f, 0x95, 0xe0, 0x78, 0x7b, 0xb6,
+    0xb0, 0x07, 0xec, 0x69, 0xaf, 0xfc, 0xd1, 0x46, 0xf5, 0x5b, 0x13, 0xfb, 0xeb, 0xa2, 0x9e, 0xf9,
+    0x41, 0xee, 0x7f, 0x00, 0xc6, 0xa1, 0xe8, 0xc9, 0xa8, 0x2b, 0x00, 0x00,
+};
+static const uint32_t CONTROLLER_UI_GZ_LEN = 4156;
+
+// Full page with the widgets inlined, rendered for everyone else
+static const char CONTROLLER_UI_TEXT_0[] =
+    "<!doctype html>\n"
+    "<html>\n"
+    "<head>\n"
+    "<meta charset='utf-8'/>\n"
+    "<meta name='viewport' content='width=device-width,initial-scale=1'/>\n"
+    "<title>Robot Controller</title>\n"
+    "<style>\n"
+    "#thrRow{margin-top:10px;}\n"
+    ".thrHeader{display:flex;align-items:center;justify-content:space-between;margin-bottom:10px;}\n"
+    ".thrLabel{font-size:16px;font-weight:600;}\n"
+    ".thrValue{font-size:16px;font-variant-numeric:tabular-nums;opacity:.9;}\n"
+    "input.thr{width:100%;height:42px;-webkit-appearance:none;appearance:none;background:transparent;touch-action:none;}\n"
+    "input.thr::-webkit-slider-runnable-track{height:12px;border-radius:999px;background:#ddd;border:1px solid #333;}\n"
+    "input.thr::-moz-range-track{height:12px;border-radius:999px;background:#ddd;border:1px solid #333;}\n"
+    "input.thr::-webkit-slider-thumb{-webkit-appearance:none;appearance:none;width:34px;height:34px;border-radius:50%;background:#333;border:2px solid #fff;margin-top:-12px;box-shadow:0 2px 6px rgba(0,0,0,.25);}\n"
+    "input.thr::-moz-range-thumb{width:34px;height:34px;border-radius:50%;background:#333;border:2px solid #fff;box-shadow:0 2px 6px rgba(0,0,0,.25);}\n"
+    "input.thr:focus{outline:none;}\n"
+    "body{font-family:system-ui,Arial;margin:16px;}\n"
+    "#wrap{max-width:520px;margin:0 auto;}\n"
+    ".row{margin:14px 0;}\n"
+    "button{padding:12px 16px;font-size:16px;border-radius:12px;border:1px solid #333;background:#f2f2f2;}\n"
+    ".uBtn{margin:6px 8px 6px 0;}\n"
+    "#joy{width:260px;height:260px;border:2px solid #333;border-radius:18px;touch-action:none;position:relative;user-select:none;-webkit-user-select:none;}\n"
+    "#stick{width:70px;height:70px;border-radius:50%;background:#333;opacity:.85;position:absolute;left:95px;top:95px;will-change:transform;}\n"
+    "label{display:block;margin-bottom:6px;}\n"
+    "input[type=range]{width:100%;}\n"
+    "#status,#telem{font-family:ui-monospace,Menlo,monospace;white-space:pre;}\n"
+    ".fs{color:#b00;font-weight:600;}\n"
+    ".empty{opacity:.7;}\n"
+    "</style>\n"
+    "</head>\n"
+    "<body>\n"
+    "<div id='wrap'>\n"
+    "<h2>Robot Controller</h2>\n"
+    "<div class='row' id='buttons'></div>\n"
+    "<div class='row' id='sliders'></div>\n"
+    "<div class='row'><div id='joy'><div id='stick'></div></div></div>\n"
+    "<div class='row' id='rotRow' hidden>\n"
+    "<label id='rotLabel' for='rot'>Rotate</label>\n"
+    "<input id='rot' type='range' min='-100' max='100' value='0' step='1'/>\n"
+    "</div>\n"
+    "<div class='row' id='thrRow'>\n"
+    "<div class='thrHeader'>\n"
+    "<div class='thrLabel'>Throttle</div>\n"
+    "<div class='thrValue'><span id='tval'>100</span>%</div>\n"
+    "</div>\n"
+    "<input id='thr' class='thr' type='range' min='0' max='100' value='100' step='1'/>\n"
+    "</div>\n"
+    "<div class='row' id='status'></div>\n"
+    "<div class='row' id='telem'></div>\n"
+    "<script id='uiData' type='application/json'>{\"throttle\":";
+static const char CONTROLLER_UI_TEXT_1[] =
+    ",\"failsafeMs\":";
+static const char CONTROLLER_UI_TEXT_2[] =
+    ",\"mode\":";
+static const char CONTROLLER_UI_TEXT_3[] =
+    ",\"buttons\":[";
+static const char CONTROLLER_UI_TEXT_4[] =
+    "],\"sliders\":[";
+static const char CONTROLLER_UI_TEXT_5[] =
+    "]}</script>\n"
+    "<script>\n"
+    "let x=0,y=0,r=0,t=100;\n"
+    "let needsR=false;      // tank and mecanum take r from the rotate control\n"
+    "let failsafeMs=1200;   // advertised by the robot in uiData / ui.json (0 = off)\n"
+    "const joy=document.getElementById('joy');\n"
+    "const stick=document.getElementById('stick');\n"
+    "const thr=document.getElementById('thr');\n"
+    "const tval=document.getElementById('tval');\n"
+    "const status=document.getElementById('status');\n"
+    "const buttonsEl=document.getElementById('buttons');\n"
+    "const slidersEl=document.getElementById('sliders');\n"
+    "const rot=document.getElementById('rot');\n"
+    "const rotRow=document.getElementById('rotRow');\n"
+    "const rotLabel=document.getElementById('rotLabel');\n"
+    "function clamp(v,a,b){return Math.max(a,Math.min(b,v));}\n"
+    "function setStick(dx,dy){stick.style.transform=`translate(${dx}px,${dy}px)`;}\n"
+    "function updateStatus(extra=''){status.textContent=`x=${x} y=${y}` + (needsR?` r=${r}`:'') + ` t=${t}` + (extra?('\\n'+extra):'');}\n"
+    "const telem=document.getElementById('telem');\n"
+    "let es=null;\n"
+    "function renderTelemetry(json){\n"
+    "let d; try{ d=JSON.parse(json); }catch(err){ return; }\n"
+    "telem.className=d.fs?'row fs':'row';\n"
+    "telem.textContent=`out L=${d.l} R=${d.r}  target L=${d.tl} R=${d.tr}` + (d.fs?'  FAILSAFE':'') +\n"
+    "`\\nloop ${d.hz} Hz, worst ${(d.maxUs/1000).toFixed(1)} ms` + (d.ovr?`, ${d.ovr} overruns`:'') + (d.sld.length?`\\nsliders ${d.sld.join(' ')}`:'');\n"
+    "}\n"
+    "function telemConnect(){\n"
+    "if (es || !window.EventSource) return;\n"
+    "es=new EventSource('/events');\n"
+    "es.onmessage=(e)=>renderTelemetry(e.data);\n"
+    "es.onerror=()=>{ telem.textContent='telemetry reconnecting...'; };\n"
+    "}\n"
+    "function telemStop(){\n"
+    "if (es){ es.close(); es=null; }\n"
+    "}\n"
+    "let ws=null,wsOpen=false;\n"
+    "function wsConnect(){\n"
+    "try{ ws=new WebSocket(`ws://${location.host}/ws`); }catch(e){ ws=null; telemConnect(); return; }\n"
+    "ws.binaryType='arraybuffer';\n"
+    "ws.onopen=()=>{\n"
+    "wsOpen=true;\n"
+    "if (wsSend(new Uint8Array([4,1]))) telemStop();   // telemetry as text frames\n"
+    "updateStatus('ws connected');\n"
+    "};\n"
+    "ws.onclose=()=>{ wsOpen=false; ws=null; telemConnect(); setTimeout(wsConnect,2000); };\n"
+    "ws.onerror=()=>{};\n"
+    "ws.onmessage=(e)=>{\n"
+    "if (typeof e.data==='string'){ renderTelemetry(e.data); return; }\n"
+    "const d=new DataView(e.data);\n"
+    "if (d.byteLength<6 || d.getUint8(0)!==0x80) return;\n"
+    "if (d.getUint8(1)===1) driveAcked();\n"
+    "updateStatus(`L=${d.getInt8(3)} R=${d.getInt8(4)}` + ((d.getUint8(5)&1)?' FAILSAFE':''));\n"
+    "};\n"
+    "}\n"
+    "function wsSend(bytes){\n"
+    "if (!wsOpen || !ws || ws.readyState!==1) return false;\n"
+    "try{ ws.send(bytes); return true; }catch(e){ return false; }\n"
+    "}\n"
+    "wsConnect();\n"
+    "function el(tag,cls,text){\n"
+    "const e=document.createElement(tag);\n"
+    "if (cls) e.className=cls;\n"
+    "if (text!==undefined) e.textContent=text;\n"
+    "return e;\n"
+    "}\n"
+    "function addButton(b){\n"
+    "const btn=el('button','uBtn',b.label);\n"
+    "btn.addEventListener('click',()=>{\n"
+    "if (!wsSend(new Uint8Array([3,b.id])))\n"
+    "fetch(`/btn?id=${b.id}&_=${Date.now()}`, {cache:'no-store'}).catch(()=>{});\n"
+    "updateStatus('btn id=' + b.id);\n"
+    "});\n"
+    "buttonsEl.appendChild(btn);\n"
+    "buttonsEl.appendChild(document.createTextNode(' '));\n"
+    "}\n"
+    "function addSlider(s){\n"
+    "const row=el('div','row sldRow');\n"
+    "const head=el('div','thrHeader');\n"
+    "head.appendChild(el('div','thrLabel',s.label));\n"
+    "const vEl=el('span','sldVal',s.value);\n"
+    "const vWrap=el('div','thrValue');\n"
+    "vWrap.appendChild(vEl);\n"
+    "head.appendChild(vWrap);\n"
+    "const inp=el('input','thr uSld');\n"
+    "inp.type='range'; inp.min=s.min; inp.max=s.max; inp.step=s.step; inp.value=s.value;\n"
+    "inp.addEventListener('input',()=>{\n"
+    "const v=parseInt(inp.value,10)||0;\n"
+    "vEl.textContent=v;\n"
+    "const m=new DataView(new ArrayBuffer(4));\n"
+    "m.setUint8(0,2); m.setUint8(1,s.id); m.setInt16(2,v,true);\n"
+    "if (!wsSend(m.buffer))\n"
+    "fetch(`/sld?id=${s.id}&v=${v}&_=${Date.now()}`, {cache:'no-store'}).catch(()=>{});\n"
+    "});\n"
+    "row.appendChild(head);\n"
+    "row.appendChild(inp);\n"
+    "slidersEl.appendChild(row);\n"
+    "}\n"
+    "function renderUi(ui){\n"
+    "buttonsEl.textContent=''; slidersEl.textContent='';\n"
+    "(ui.buttons||[]).forEach(addButton);\n"
+    "(ui.sliders||[]).forEach(addSlider);\n"
+    "if (!buttonsEl.children.length) buttonsEl.appendChild(el('div','empty','No buttons registered'));\n"
+    "if (!slidersEl.children.length) slidersEl.appendChild(el('div','empty','No sliders registered'));\n"
+    "if (ui.throttle!==undefined){ t=ui.throttle; thr.value=t; tval.textContent=t; }\n"
+    "if (ui.failsafeMs!==undefined) failsafeMs=ui.failsafeMs;\n"
+    "if (ui.mode!==undefined) setMode(ui.mode);\n"
+    "}\n"
+    "function setMode(mode){\n"
+    "needsR=(mode==='tank' || mode==='mecanum');\n"
+    "rotRow.hidden=!needsR;\n"
+    "rotLabel.textContent=(mode==='tank') ? 'Right track' : 'Rotate';\n"
+    "}\n"
+    "const uiData=document.getElementById('uiData');\n"
+    "if (uiData) renderUi(JSON.parse(uiData.textContent));\n"
+    "else fetch('/ui.json',{cache:'no-store'}).then(r=>r.json()).then(renderUi).catch(()=>updateStatus('ui.json failed'));\n"
+    "let srtt=0,rttvar=0;          // smoothed RTT and its variation (RFC 6298)\n"
+    "let inFlight=false,inFlightAt=0,rttSample=false;\n"
+    "let pending=false,paceTimer=null;\n"
+    "let lastSentX=999,lastSentY=999,lastSentR=999,lastSentT=999;\n"
+    "let lastSendMs=0;\n"
+    "function noteRtt(ms){\n"
+    "if (!srtt){ srtt=ms; rttvar=ms/2; return; }\n"
+    "rttvar=0.75*rttvar + 0.25*Math.abs(srtt-ms);\n"
+    "srtt=0.875*srtt + 0.125*ms;\n"
+    "}\n"
+    "function rtoMs(){ return srtt ? clamp(srtt + 4*rttvar, 100, 2000) : 500; }\n"
+    "function minGapMs(){ return clamp(Math.round(srtt), 20, 250); }\n"
+    "function heartbeatMs(){\n"
+    "if (!failsafeMs) return 1000;\n"
+    "return clamp(Math.round((failsafeMs - rtoMs())/2), 50, 1000);\n"
+    "}\n"
+    "function driveAcked(){\n"
+    "if (!inFlight) return;\n"
+    "if (rttSample) noteRtt(performance.now() - inFlightAt);\n"
+    "inFlight=false;\n"
+    "if (pending) schedule();\n"
+    "}\n"
+    "function schedule(){\n"
+    "if (paceTimer) return;\n"
+    "const now=performance.now();\n"
+    "let wait=lastSendMs + minGapMs() - now;\n"
+    "if (inFlight) wait=Math.max(wait, inFlightAt + rtoMs() - now);\n"
+    "paceTimer=setTimeout(()=>{ paceTimer=null; if (pending) sendDriveNow(); }, Math.max(0,wait));\n"
+    "}\n"
+    "function sendDriveNow(heartbeat=false){\n"
+    "const now=performance.now();\n"
+    "const same = (x===lastSentX && y===lastSentY && r===lastSentR && t===lastSentT);\n"
+    "if (same && !heartbeat){ pending=false; return; }          // nothing new to say\n"
+    "const isStop = (x===0 && y===0 && r===0);\n"
+    "if (inFlight && now - inFlightAt > rtoMs()) inFlight=false;   // lost\n"
+    "if (!(isStop && !same) && (inFlight || now - lastSendMs < minGapMs())){\n"
+    "pending=true;\n"
+    "schedule();\n"
+    "return;\n"
+    "}\n"
+    "rttSample=!inFlight;\n"
+    "pending=false; inFlight=true; inFlightAt=now; lastSendMs=now;\n"
+    "lastSentX=x; lastSentY=y; lastSentR=r; lastSentT=t;\n"
+    "if (wsSend(new Int8Array([1,x,y,t,r]))) return;\n"
+    "const sentAt=inFlightAt;\n"
+    "fetch(`/drive?x=${x}&y=${y}&r=${r}&t=${t}&_=${Date.now()}`,{cache:'no-store'})\n"
+    ".then(()=>{ if (inFlightAt===sentAt) driveAcked(); })\n"
+    ".catch(()=>{\n"
+    "if (inFlightAt!==sentAt) return;\n"
+    "inFlight=false; lastSentX=999;   // not delivered: send the latest again\n"
+    "pending=true; schedule();\n"
+    "});\n"
+    "}\n"
+    "function heartbeat(){\n"
+    "if ((x!==0 || y!==0 || r!==0) && performance.now() - lastSendMs >= heartbeatMs()) sendDriveNow(true);\n"
+    "setTimeout(heartbeat, 50);\n"
+    "}\n"
+    "heartbeat();\n"
+    "let rawX=0,rawY=0,dragging=false,frameQueued=false,note='';\n"
+    "let joyRect=null;   // cached joystick geometry, dropped on resize/scroll\n"
+    "function joyGeometry(){\n"
+    "if (!joyRect) joyRect=joy.getBoundingClientRect();\n"
+    "return joyRect;\n"
+    "}\n"
+    "window.addEventListener('resize',()=>{ joyRect=null; });\n"
+    "window.addEventListener('scroll',()=>{ joyRect=null; },{passive:true});\n"
+    "function queueFrame(){\n"
+    "if (frameQueued) return;\n"
+    "frameQueued=true;\n"
+    "requestAnimationFrame(inputFrame);\n"
+    "}\n"
+    "function inputFrame(){\n"
+    "frameQueued=false;\n"
+    "let ndx=0,ndy=0;\n"
+    "if (dragging){\n"
+    "const r=joyGeometry();\n"
+    "const max=r.width/2 - 35;\n"
+    "ndx=clamp(rawX - r.left - r.width/2,-max,max);\n"
+    "ndy=clamp(rawY - r.top - r.height/2,-max,max);\n"
+    "x=Math.round((ndx/max)*100);\n"
+    "y=Math.round((-ndy/max)*100);\n"
+    "if (Math.abs(x) < 4) x=0;\n"
+    "if (Math.abs(y) < 4) y=0;\n"
+    "}\n"
+    "setStick(ndx,ndy);\n"
+    "updateStatus(note);\n"
+    "note='';\n"
+    "sendDriveNow();\n"
+    "}\n"
+    "function release(why){\n"
+    "dragging=false;\n"
+    "x=0; y=0;\n"
+    "note=why;\n"
+    "sendDriveNow();\n"
+    "queueFrame();\n"
+    "}\n"
+    "joy.addEventListener('pointerdown',(e)=>{\n"
+    "dragging=true;\n"
+    "joy.setPointerCapture(e.pointerId);\n"
+    "rawX=e.clientX; rawY=e.clientY;\n"
+    "joyRect=null;   // the page may have moved since the last drag\n"
+    "queueFrame();\n"
+    "});\n"
+    "joy.addEventListener('pointermove',(e)=>{\n"
+    "if(!dragging) return;\n"
+    "rawX=e.clientX; rawY=e.clientY;\n"
+    "queueFrame();\n"
+    "});\n"
+    "joy.addEventListener('pointerup',()=>release('released'));\n"
+    "joy.addEventListener('pointercancel',()=>release('cancel'));\n"
+    "rot.addEventListener('input',()=>{\n"
+    "r=parseInt(rot.value,10)||0;\n"
+    "if (Math.abs(r) < 4) r=0;\n"
+    "queueFrame();\n"
+    "});\n"
+    "function releaseRot(){\n"
+    "rot.value=0; r=0;\n"
+    "note='rotate released';\n"
+    "sendDriveNow();\n"
+    "queueFrame();\n"
+    "}\n"
+    "rot.addEventListener('pointerup',releaseRot);\n"
+    "rot.addEventListener('pointercancel',releaseRot);\n"
+    "thr.addEventListener('input',()=>{\n"
+    "t=parseInt(thr.value,10)||0;\n"
+    "tval.textContent=t;\n"
+    "note='slider';\n"
+    "queueFrame();\n"
+    "});\n"
+    "updateStatus('ready');\n"
+    "sendDriveNow(true);\n"
+    "</script>\n"
+    "</div>\n"
+    "</body>\n"
+    "</html>\n";
+
+static const TemplateFragment CONTROLLER_UI_TEMPLATE[] = {
+    { CONTROLLER_UI_TEXT_0, sizeof(CONTROLLER_UI_TEXT_0) - 1, CONTROLLER_UI_SLOT_THROTTLE },
+    { CONTROLLER_UI_TEXT_1, sizeof(CONTROLLER_UI_TEXT_1) - 1, CONTROLLER_UI_SLOT_FAILSAFE },
+    { CONTROLLER_UI_TEXT_2, sizeof(CONTROLLER_UI_TEXT_2) - 1, CONTROLLER_UI_SLOT_MODE },
+    { CONTROLLER_UI_TEXT_3, sizeof(CONTROLLER_UI_TEXT_3) - 1, CONTROLLER_UI_SLOT_BUTTONS },
+    { CONTROLLER_UI_TEXT_4, sizeof(CONTROLLER_UI_TEXT_4) - 1, CONTROLLER_UI_SLOT_SLIDERS },
+    { CONTROLLER_UI_TEXT_5, sizeof(CONTROLLER_UI_TEXT_5) - 1, TEMPLATE_NO_SLOT },
+};
+static const uint8_t CONTROLLER_UI_TEMPLATE_COUNT = 6;
+
+static const char CONTROLLER_UI_HASH[] = "4351a22d";
+
+#endif // THEFORGE2026_CONTROLLER_UI_H
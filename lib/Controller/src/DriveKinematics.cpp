@@ -0,0 +1,88 @@
+//
+// Stick-to-motor mixing for Controller's drive modes.
+//
+
+#include "DriveKinematics.h"
+
+// Below this forward speed curvature drive blends into turning in place
+static constexpr int CURVATURE_QUICK_TURN = 10;
+
+static int clampAxis(int v, int lo, int hi) {
+    if (v < lo) return lo;
+    if (v > hi) return hi;
+    return v;
+}
+
+// Scale every output by the same factor if any exceeds 100, then apply throttle
+static void normalize(int* v, uint8_t count, int t, int8_t* out) {
+    int peak = 100;
+    for (uint8_t i = 0; i < count; i++) {
+        const int a = v[i] < 0 ? -v[i] : v[i];
+        if (a > peak) peak = a;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        out[i] = (int8_t)((long)v[i] * t / peak);
+    }
+}
+
+uint8_t driveMotorCount(DriveMode mode) {
+    return mode == DRIVE_MECANUM ? 4 : 2;
+}
+
+const char* driveModeName(DriveMode mode) {
+    switch (mode) {
+        case DRIVE_TANK:      return "tank";
+        case DRIVE_CURVATURE: return "curvature";
+        case DRIVE_MECANUM:   return "mecanum";
+        case DRIVE_ARCADE:
+        default:              return "arcade";
+    }
+}
+
+uint8_t mixDrive(DriveMode mode, const DriveInput& in, int8_t out[DRIVE_MAX_MOTORS]) {
+    const int x = clampAxis(in.x, -100, 100);
+    const int y = clampAxis(in.y, -100, 100);
+    const int r = clampAxis(in.r, -100, 100);
+    const int t = clampAxis(in.t, 0, 100);
+
+    int v[DRIVE_MAX_MOTORS];
+
+    switch (mode) {
+        case DRIVE_TANK:
+            out[0] = (int8_t)(y * t / 100);
+            out[1] = (int8_t)(r * t / 100);
+            return 2;
+
+        case DRIVE_CURVATURE: {
+            // Turn rate proportional to speed: the stick sets the arc, not the spin.
+            // Below the quick-turn speed crossfade towards a spin in place, so
+            // the outputs stay continuous as the robot slows to a stop.
+            const int speed = y < 0 ? -y : y;
+            int turn;
+            if (speed < CURVATURE_QUICK_TURN) {
+                const int spin = CURVATURE_QUICK_TURN - speed;
+                turn = (x * spin * 100 + x * speed * speed) / (CURVATURE_QUICK_TURN * 100);
+            } else {
+                turn = x * speed / 100;
+            }
+            v[0] = y + turn;
+            v[1] = y - turn;
+            normalize(v, 2, t, out);
+            return 2;
+        }
+
+        case DRIVE_MECANUM:
+            v[0] = y + x + r;
+            v[1] = y - x - r;
+            v[2] = y - x + r;
+            v[3] = y + x - r;
+            normalize(v, 4, t, out);
+            return 4;
+
+        case DRIVE_ARCADE:
+        default:
+            out[0] = (int8_t)(clampAxis(y + x, -100, 100) * t / 100);
+            out[1] = (int8_t)(clampAxis(y - x, -100, 100) * t / 100);
+            return 2;
+    }
+}
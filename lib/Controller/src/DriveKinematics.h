@@ -0,0 +1,41 @@
+//
+// Stick-to-motor mixing for Controller's drive modes.
+//
+
+#ifndef THEFORGE2026_DRIVE_KINEMATICS_H
+#define THEFORGE2026_DRIVE_KINEMATICS_H
+
+#include <stdint.h>
+
+static constexpr uint8_t DRIVE_MAX_MOTORS = 4;
+
+// Motor order in the output vector:
+//   2-motor modes: 0 left, 1 right
+//   DRIVE_MECANUM: 0 front-left, 1 front-right, 2 rear-left, 3 rear-right
+enum DriveMode : uint8_t {
+    DRIVE_ARCADE,      // y forward, x turn
+    DRIVE_TANK,        // y left stick, r right stick
+    DRIVE_CURVATURE,   // y forward, x curvature (turn rate scales with speed)
+    DRIVE_MECANUM      // y forward, x strafe, r rotate
+};
+
+// One drive command as received from the page, UDP or WebSocket.
+// Axes are -100..100, throttle 0..100 scales the result.
+struct DriveInput {
+    int x = 0;
+    int y = 0;
+    int r = 0;
+    int t = 100;
+};
+
+uint8_t driveMotorCount(DriveMode mode);
+
+// Lowercase name as advertised to the page in /ui.json ("arcade", "tank", ...)
+const char* driveModeName(DriveMode mode);
+
+// Fills out[0..count) with -100..100 and returns count. Arcade clamps each
+// side like the original mixer; the other modes scale all outputs down
+// together when one would exceed 100, so the motion keeps its direction.
+uint8_t mixDrive(DriveMode mode, const DriveInput& in, int8_t out[DRIVE_MAX_MOTORS]);
+
+#endif // THEFORGE2026_DRIVE_KINEMATICS_H
@@ -0,0 +1,44 @@
+//
+// RC speed controller (ESC) policy for MotorDriver, driven by servo pulses.
+//
+
+#ifndef THEFORGE2026_ESC_DRIVER_H
+#define THEFORGE2026_ESC_DRIVER_H
+
+#include <Servo.h>
+
+#include "MotorDriver.h"
+
+// Bidirectional (car/robot) ESCs: neutral pulse at rest, minUs full
+// reverse, maxUs full forward. Include this header from the sketch; it
+// pulls in the Servo library, which the rest of Controller does not need.
+//
+//   MotorDriver<RcEsc, 2> motors({ { 5 }, { 6 } });
+//   controller.attachMotorDriver(motors);
+//
+// Speeds map linearly onto the pulse width; the controller's min-PWM table
+// is not used because ESCs have their own deadband and calibration.
+struct RcEsc {
+    struct Channel {
+        uint8_t pin;
+        Servo servo;
+    };
+
+    uint16_t minUs = 1000;
+    uint16_t maxUs = 2000;
+
+    void enable(bool) {}
+
+    void begin(Channel& ch) {
+        ch.servo.attach(ch.pin, minUs, maxUs);
+        write(ch, 0, 0);   // ESCs arm on neutral
+    }
+
+    void write(Channel& ch, int8_t speed, uint16_t) {
+        const int neutral = (minUs + maxUs) / 2;
+        const int span = (maxUs - minUs) / 2;
+        ch.servo.writeMicroseconds(neutral + (long)speed * span / 100);
+    }
+};
+
+#endif // THEFORGE2026_ESC_DRIVER_H
@@ -0,0 +1,49 @@
+//
+// Fixed-size single-producer/single-consumer queue for Controller events.
+//
+
+#ifndef THEFORGE2026_EVENT_QUEUE_H
+#define THEFORGE2026_EVENT_QUEUE_H
+
+#include <stdint.h>
+
+// Ring buffer of N items (a power of two, at most 128). The producer only
+// writes _head and the consumer only writes _tail, so one side may run in
+// an interrupt without a lock: an item is copied in before _head moves
+// past it and copied out before _tail does. Both indices run freely and
+// wrap at 256; head - tail is the fill level.
+template <typename T, uint8_t N>
+class SpscQueue {
+    static_assert(N > 0 && N <= 128 && (N & (N - 1)) == 0, "N must be a power of two <= 128");
+
+public:
+    static constexpr uint8_t CAPACITY = N;
+
+    // False (and nothing queued) when full
+    bool push(const T& item) {
+        const uint8_t head = _head;
+        if ((uint8_t)(head - _tail) >= N) return false;
+        _items[head & (N - 1)] = item;
+        _head = (uint8_t)(head + 1);
+        return true;
+    }
+
+    // False when empty
+    bool pop(T& out) {
+        const uint8_t tail = _tail;
+        if (tail == _head) return false;
+        out = _items[tail & (N - 1)];
+        _tail = (uint8_t)(tail + 1);
+        return true;
+    }
+
+    uint8_t size() const { return (uint8_t)(_head - _tail); }
+    bool empty() const { return _head == _tail; }
+
+private:
+    T _items[N];
+    volatile uint8_t _head = 0;   // next slot to write (producer)
+    volatile uint8_t _tail = 0;   // next slot to read (consumer)
+};
+
+#endif // THEFORGE2026_EVENT_QUEUE_H
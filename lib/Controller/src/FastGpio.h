@@ -0,0 +1,73 @@
+//
+// Direct port-register writes for motor direction pins (Renesas RA).
+//
+
+#ifndef THEFORGE2026_FAST_GPIO_H
+#define THEFORGE2026_FAST_GPIO_H
+
+#include <Arduino.h>
+
+// The two direction inputs of one H-bridge channel. begin() looks the pins
+// up once and keeps the port's PCNTR3 register and bit masks, the same way
+// the Servo library's Renesas backend drives its pins. write() then sets
+// and clears both pins with a single register store when they share a
+// port: PCNTR3's low half sets bits and its high half clears them, so the
+// bridge never sees an in-between state. Pins on different ports take two
+// stores, set before clear, so the in-between state is brake (both high)
+// rather than a brief coast.
+class DirectionPins {
+public:
+    void begin(uint8_t pinA, uint8_t pinB) {
+        pinMode(pinA, OUTPUT);
+        pinMode(pinB, OUTPUT);
+#if defined(ARDUINO_ARCH_RENESAS)
+        const bsp_io_port_pin_t a = g_pin_cfg[pinA].pin;
+        const bsp_io_port_pin_t b = g_pin_cfg[pinB].pin;
+        _portA = portRegister(a);
+        _portB = portRegister(b);
+        _maskA = 1UL << (a & 0xFF);
+        _maskB = 1UL << (b & 0xFF);
+#else
+        _pinA = pinA;
+        _pinB = pinB;
+#endif
+    }
+
+    void write(bool a, bool b) {
+#if defined(ARDUINO_ARCH_RENESAS)
+        if (_portA == _portB) {
+            const uint32_t set = (a ? _maskA : 0) | (b ? _maskB : 0);
+            const uint32_t clr = (a ? 0 : _maskA) | (b ? 0 : _maskB);
+            *_portA = set | (clr << 16);
+            return;
+        }
+        if (a) *_portA = _maskA;
+        if (b) *_portB = _maskB;
+        if (!a) *_portA = _maskA << 16;
+        if (!b) *_portB = _maskB << 16;
+#else
+        if (a) digitalWrite(_pinA, HIGH);
+        if (b) digitalWrite(_pinB, HIGH);
+        if (!a) digitalWrite(_pinA, LOW);
+        if (!b) digitalWrite(_pinB, LOW);
+#endif
+    }
+
+private:
+#if defined(ARDUINO_ARCH_RENESAS)
+    static volatile uint32_t* portRegister(bsp_io_port_pin_t pin) {
+        const uint32_t port = ((uint32_t)pin >> 8) & 0xFF;
+        return &((R_PORT0 + (uint32_t)(R_PORT1 - R_PORT0) * port)->PCNTR3);
+    }
+
+    volatile uint32_t* _portA = nullptr;
+    volatile uint32_t* _portB = nullptr;
+    uint32_t _maskA = 0;
+    uint32_t _maskB = 0;
+#else
+    uint8_t _pinA = 255;
+    uint8_t _pinB = 255;
+#endif
+};
+
+#endif // THEFORGE2026_FAST_GPIO_H
@@ -0,0 +1,31 @@
+//
+// GPT timer setup and duty math for high-frequency motor PWM (Renesas RA).
+//
+
+#include "GptPwm.h"
+
+static constexpr uint8_t GPT_MAX_PRESCALER = 5;   // clock / 1024
+
+bool gptPwmTiming(uint32_t clockHz, uint32_t pwmHz, uint32_t counterMax, GptPwmTiming& out) {
+    if (pwmHz == 0 || clockHz == 0) return false;
+
+    for (uint8_t p = 0; p <= GPT_MAX_PRESCALER; p++) {
+        const uint32_t tickHz = clockHz >> (2 * p);
+        const uint32_t counts = (tickHz + pwmHz / 2) / pwmHz;
+        if (counts < 256) return false;            // under 8 bits: too fast
+        if (counts - 1 > counterMax) continue;     // too slow for this prescaler
+
+        out.prescaler = p;
+        out.periodCounts = counts;
+        out.resolutionBits = 0;
+        while ((counts >> out.resolutionBits) > 1) out.resolutionBits++;
+        return true;
+    }
+    return false;
+}
+
+uint32_t gptDutyCounts(uint16_t duty, uint32_t periodCounts) {
+    if (duty == 0) return 0;
+    if (duty == 0xFFFF) return periodCounts;
+    return (uint32_t)(((uint64_t)duty * periodCounts + 0x7FFF) / 0xFFFF);
+}
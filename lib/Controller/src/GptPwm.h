@@ -0,0 +1,90 @@
+//
+// GPT timer setup and duty math for high-frequency motor PWM (Renesas RA).
+//
+
+#ifndef THEFORGE2026_GPT_PWM_H
+#define THEFORGE2026_GPT_PWM_H
+
+#include <stdint.h>
+
+// The register helpers are templates over the register block so the same
+// code runs on R_GPT0_Type on the board and on a plain struct in host tests.
+// Bit positions: RA4M1 user's manual, General PWM Timer (GPT).
+static constexpr uint32_t GPT_GTWP_UNLOCK     = 0xA500;       // PRKEY, WP = 0
+static constexpr uint32_t GPT_GTCR_CST        = 1UL << 0;     // count start
+static constexpr uint8_t  GPT_GTCR_TPCS_SHIFT = 24;           // prescaler select
+static constexpr uint32_t GPT_GTUDDTYC_UD     = 1UL << 0;     // count up
+static constexpr uint8_t  GPT_GTUDDTYC_OADTY_SHIFT = 16;      // forced duty, output A
+static constexpr uint8_t  GPT_GTUDDTYC_OBDTY_SHIFT = 24;      // forced duty, output B
+static constexpr uint32_t GPT_DUTY_NORMAL     = 0;            // OxDTY values
+static constexpr uint32_t GPT_DUTY_0          = 2;
+static constexpr uint32_t GPT_DUTY_100        = 3;
+static constexpr uint32_t GPT_GTIOR_PWM       = 0x19;         // high at cycle end, low at compare, starts high
+static constexpr uint32_t GPT_GTIOR_OAE       = 1UL << 8;
+static constexpr uint8_t  GPT_GTIOR_B_SHIFT   = 16;           // GTIOB/OBE: GTIOA/OAE + 16
+static constexpr uint32_t GPT_GTBER_BUFFERED  = (1UL << 16) | (1UL << 18) | (1UL << 20);  // CCRA, CCRB, PR single buffer
+
+// GTCCR index: A/B are the live compare values, C/D their buffers
+static constexpr uint8_t GPT_CCR_A = 0;
+static constexpr uint8_t GPT_CCR_B = 1;
+static constexpr uint8_t GPT_CCR_C = 2;
+static constexpr uint8_t GPT_CCR_D = 3;
+
+struct GptPwmTiming {
+    uint8_t prescaler = 0;        // TPCS: clock / 4^prescaler (1, 4 .. 1024)
+    uint32_t periodCounts = 0;    // counts per PWM period (GTPR + 1)
+    uint8_t resolutionBits = 0;   // floor(log2(periodCounts))
+};
+
+// Smallest prescaler that fits one period in counterMax. False when the
+// frequency is unreachable or leaves fewer than 8 bits of duty resolution.
+bool gptPwmTiming(uint32_t clockHz, uint32_t pwmHz, uint32_t counterMax, GptPwmTiming& out);
+
+// 16-bit duty 0..0xFFFF to a compare value, rounded. 0 and 0xFFFF are
+// returned as 0 and periodCounts and applied as forced 0% / 100% by
+// gptPwmSetDuty().
+uint32_t gptDutyCounts(uint16_t duty, uint32_t periodCounts);
+
+// Saw-wave PWM, counting up, with the compare and period registers buffered
+// so new values take effect at the next cycle end. If the timer is already
+// running at this period (the other output of the channel was set up
+// first) only this output is enabled. The output starts at 0%.
+template <typename Regs>
+void gptPwmConfigure(Regs& r, const GptPwmTiming& t, bool outputA) {
+    r.GTWP = GPT_GTWP_UNLOCK;
+
+    const bool running = (r.GTCR & GPT_GTCR_CST) != 0;
+    if (!running || r.GTPR != t.periodCounts - 1) {
+        r.GTCR = 0;
+        r.GTUDDTYC = GPT_GTUDDTYC_UD
+                   | (GPT_DUTY_0 << GPT_GTUDDTYC_OADTY_SHIFT)
+                   | (GPT_DUTY_0 << GPT_GTUDDTYC_OBDTY_SHIFT);
+        r.GTBER = GPT_GTBER_BUFFERED;
+        r.GTPR = t.periodCounts - 1;
+        r.GTPBR = t.periodCounts - 1;
+        for (uint8_t i = GPT_CCR_A; i <= GPT_CCR_D; i++) r.GTCCR[i] = 0;
+        r.GTCNT = 0;
+        r.GTIOR = 0;
+        r.GTCR = (uint32_t)t.prescaler << GPT_GTCR_TPCS_SHIFT;
+    }
+
+    const uint8_t shift = outputA ? 0 : GPT_GTIOR_B_SHIFT;
+    r.GTIOR = r.GTIOR | ((GPT_GTIOR_PWM | GPT_GTIOR_OAE) << shift);
+    r.GTCR = r.GTCR | GPT_GTCR_CST;
+}
+
+// Double-buffered duty update: the compare value goes to the buffer
+// register and reaches the output at the next period boundary, so a
+// period is never cut short or stretched.
+template <typename Regs>
+void gptPwmSetDuty(Regs& r, bool outputA, uint32_t counts, uint32_t periodCounts) {
+    uint32_t forced = GPT_DUTY_NORMAL;
+    if (counts == 0) forced = GPT_DUTY_0;
+    else if (counts >= periodCounts) forced = GPT_DUTY_100;
+    else r.GTCCR[outputA ? GPT_CCR_C : GPT_CCR_D] = counts;
+
+    const uint8_t shift = outputA ? GPT_GTUDDTYC_OADTY_SHIFT : GPT_GTUDDTYC_OBDTY_SHIFT;
+    r.GTUDDTYC = (r.GTUDDTYC & ~(3UL << shift)) | (forced << shift);
+}
+
+#endif // THEFORGE2026_GPT_PWM_H
@@ -0,0 +1,302 @@
+//
+// Incremental HTTP request parser used by Controller's connection table.
+//
+
+#include "HttpRequestParser.h"
+
+#include <string.h>
+
+// -------------------- HttpRequest --------------------
+
+bool HttpRequest::isGet(const char* p) const {
+    return strcmp(method, "GET") == 0 && strcmp(path, p) == 0;
+}
+
+const char* HttpRequest::param(const char* key) const {
+    for (uint8_t i = 0; i < paramCount; i++) {
+        if (strcmp(keys[i], key) == 0) return values[i];
+    }
+    return nullptr;
+}
+
+bool HttpRequest::paramInt(const char* key, int& out) const {
+    const char* v = param(key);
+    if (!v) return false;
+
+    bool neg = false;
+    if (*v == '-' || *v == '+') neg = (*v++ == '-');
+    if (*v < '0' || *v > '9') return false;
+
+    long n = 0;
+    while (*v >= '0' && *v <= '9') {
+        n = n * 10 + (*v++ - '0');
+        if (n > 1000000L) n = 1000000L;   // callers clamp to small ranges anyway
+    }
+    out = (int)(neg ? -n : n);
+    return true;
+}
+
+bool HttpRequest::etagMatches(const char* etag) const {
+    // If-None-Match: "a", W/"b"  or  *
+    const size_t etagLen = strlen(etag);
+    const char* p = ifNoneMatch;
+    while (*p) {
+        while (*p == ' ' || *p == '\t' || *p == ',') p++;
+        if (*p == '*') return true;
+        if (p[0] == 'W' && p[1] == '/') p += 2;
+
+        const char* start = p;
+        while (*p && *p != ',' && *p != ' ' && *p != '\t') p++;
+        if ((size_t)(p - start) == etagLen && strncmp(start, etag, etagLen) == 0) return true;
+    }
+    return false;
+}
+
+// -------------------- HttpRequestParser --------------------
+
+HttpRequestParser::HttpRequestParser() {
+    reset();
+}
+
+void HttpRequestParser::reset() {
+    _line[0] = '\0';
+    _lineLen = 0;
+    _request = HttpRequest();
+    _headerLen = 0;
+    _state = READ_REQUEST_LINE;
+    _connClose = false;
+    _connKeepAlive = false;
+    _connUpgrade = false;
+    _upgradeWebSocket = false;
+    _wsKey[0] = '\0';
+    _ifNoneMatch[0] = '\0';
+}
+
+bool HttpRequestParser::keepAliveRequested() const {
+    if (_connClose) return false;
+    if (_request.httpMinor >= 1) return true;
+    return _connKeepAlive;
+}
+
+bool HttpRequestParser::webSocketUpgradeRequested() const {
+    return _connUpgrade && _upgradeWebSocket && _wsKey[0] != '\0';
+}
+
+HttpRequestParser::State HttpRequestParser::feed(char c) {
+    switch (_state) {
+
+        case READ_REQUEST_LINE:
+            if (c == '\r') break;
+            if (c == '\n') {
+                // Tolerate stray CRLFs before a request (RFC 7230 3.5)
+                if (_lineLen == 0) break;
+                _line[_lineLen] = '\0';
+                parseVersion();
+                tokenizeRequestLine();
+                _headerLen = 0;
+                _state = READ_HEADERS;
+                break;
+            }
+            if (_lineLen >= MAX_REQUEST_LINE) {
+                _line[_lineLen] = '\0';
+                _state = ERROR;
+                break;
+            }
+            _line[_lineLen++] = c;
+            break;
+
+        case READ_HEADERS:
+            if (c == '\r') break;
+            if (c == '\n') {
+                // Empty line terminates the header block
+                if (_headerLen == 0) {
+                    _state = COMPLETE;
+                    break;
+                }
+                _header[_headerLen] = '\0';
+                parseHeaderLine();
+                _headerLen = 0;
+                break;
+            }
+            if (_headerLen < MAX_HEADER_LINE) _header[_headerLen++] = c;
+            break;
+
+        case COMPLETE:
+        case ERROR:
+            break;
+    }
+    return _state;
+}
+
+void HttpRequestParser::parseVersion() {
+    // "GET /path HTTP/1.1" -> the version is the last token
+    static const char prefix[] = "HTTP/1.";
+    const uint8_t prefixLen = sizeof(prefix) - 1;
+
+    if (_lineLen < prefixLen + 1) return;
+    const char* v = _line + _lineLen - (prefixLen + 1);
+    if (strncmp(v, prefix, prefixLen) != 0) return;
+
+    char minor = v[prefixLen];
+    if (minor >= '0' && minor <= '9') _request.httpMinor = (uint8_t)(minor - '0');
+}
+
+void HttpRequestParser::tokenizeRequestLine() {
+    // Single pass over "METHOD target VERSION": separators become NULs
+    char* p = _line;
+    _request.method = p;
+    while (*p && *p != ' ') p++;
+    if (!*p) return;
+    *p++ = '\0';
+
+    _request.path = p;
+    while (*p && *p != ' ' && *p != '?') p++;
+    if (!*p) return;
+
+    if (*p == ' ') {
+        *p = '\0';
+        return;
+    }
+
+    // Query: key=value pairs separated by '&', up to the next space
+    *p++ = '\0';
+    while (*p && *p != ' ') {
+        char* key = p;
+        char* value = nullptr;
+        while (*p && *p != ' ' && *p != '&') {
+            if (*p == '=' && !value) {
+                *p = '\0';
+                value = p + 1;
+            }
+            p++;
+        }
+        const bool last = (*p == '\0' || *p == ' ');
+        *p = '\0';
+
+        if (*key && _request.paramCount < HttpRequest::MAX_PARAMS) {
+            _request.keys[_request.paramCount] = decodeInPlace(key);
+            _request.values[_request.paramCount] = value ? decodeInPlace(value) : key + strlen(key);
+            _request.paramCount++;
+        }
+
+        if (last) break;
+        p++;
+    }
+}
+
+char* HttpRequestParser::decodeInPlace(char* s) {
+    // '+' -> space, %XX -> byte; malformed escapes are kept literally
+    auto hex = [](char c) -> int {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    };
+
+    char* out = s;
+    for (char* in = s; *in; in++) {
+        if (*in == '+') {
+            *out++ = ' ';
+        } else if (*in == '%' && hex(in[1]) >= 0 && hex(in[2]) >= 0) {
+            *out++ = (char)((hex(in[1]) << 4) | hex(in[2]));
+            in += 2;
+        } else {
+            *out++ = *in;
+        }
+    }
+    *out = '\0';
+    return s;
+}
+
+void HttpRequestParser::parseHeaderLine() {
+    const char* colon = strchr(_header, ':');
+    if (!colon) return;
+
+    const uint8_t nameLen = (uint8_t)(colon - _header);
+    const char* value = colon + 1;
+    while (*value == ' ' || *value == '\t') value++;
+
+    if (equalsIgnoreCase(_header, nameLen, "connection")) {
+        if (hasTokenIgnoreCase(value, "close")) _connClose = true;
+        if (hasTokenIgnoreCase(value, "keep-alive")) _connKeepAlive = true;
+        if (hasTokenIgnoreCase(value, "upgrade")) _connUpgrade = true;
+    } else if (equalsIgnoreCase(_header, nameLen, "accept-encoding")) {
+        if (acceptsCoding(value, "gzip")) _request.acceptsGzip = true;
+    } else if (equalsIgnoreCase(_header, nameLen, "upgrade")) {
+        if (hasTokenIgnoreCase(value, "websocket")) _upgradeWebSocket = true;
+    } else if (equalsIgnoreCase(_header, nameLen, "if-none-match")) {
+        // A truncated list could match by accident: keep it only if it fits
+        const size_t n = strlen(value);
+        if (n <= MAX_IF_NONE_MATCH && _headerLen < MAX_HEADER_LINE) {
+            memcpy(_ifNoneMatch, value, n + 1);
+            _request.ifNoneMatch = _ifNoneMatch;
+        }
+    } else if (equalsIgnoreCase(_header, nameLen, "sec-websocket-key")) {
+        uint8_t n = 0;
+        while (n < sizeof(_wsKey) - 1 && value[n] && value[n] != ' ') {
+            _wsKey[n] = value[n];
+            n++;
+        }
+        _wsKey[n] = '\0';
+    }
+}
+
+bool HttpRequestParser::equalsIgnoreCase(const char* a, uint8_t len, const char* b) {
+    for (uint8_t i = 0; i < len; i++) {
+        char ca = a[i];
+        char cb = b[i];
+        if (cb == '\0') return false;
+        if (ca >= 'A' && ca <= 'Z') ca = (char)(ca - 'A' + 'a');
+        if (cb >= 'A' && cb <= 'Z') cb = (char)(cb - 'A' + 'a');
+        if (ca != cb) return false;
+    }
+    return b[len] == '\0';
+}
+
+bool HttpRequestParser::hasTokenIgnoreCase(const char* list, const char* token) {
+    // Comma-separated list, e.g. "keep-alive, Upgrade" or "gzip;q=1.0, br"
+    const uint8_t tokenLen = (uint8_t)strlen(token);
+    const char* p = list;
+    while (*p) {
+        while (*p == ' ' || *p == '\t' || *p == ',') p++;
+        const char* start = p;
+        while (*p && *p != ',' && *p != ';') p++;
+        const char* end = p;
+        while (*p && *p != ',') p++;   // skip parameters
+        while (end > start && (end[-1] == ' ' || end[-1] == '\t')) end--;
+        if ((uint8_t)(end - start) == tokenLen && equalsIgnoreCase(start, tokenLen, token)) return true;
+    }
+    return false;
+}
+
+bool HttpRequestParser::acceptsCoding(const char* list, const char* coding) {
+    // Accept-Encoding list, e.g. "gzip;q=0.8, br". The coding is accepted
+    // when it is listed without q=0 ("gzip;q=0" means "never send gzip").
+    const uint8_t codingLen = (uint8_t)strlen(coding);
+    const char* p = list;
+    while (*p) {
+        while (*p == ' ' || *p == '\t' || *p == ',') p++;
+        const char* start = p;
+        while (*p && *p != ',' && *p != ';') p++;
+        const char* end = p;
+        while (end > start && (end[-1] == ' ' || end[-1] == '\t')) end--;
+        const bool match = (uint8_t)(end - start) == codingLen && equalsIgnoreCase(start, codingLen, coding);
+
+        // Parameters: only q matters, and only whether it is zero
+        bool zero = false;
+        while (*p == ';') {
+            p++;
+            while (*p == ' ' || *p == '\t') p++;
+            const bool isQ = (*p == 'q' || *p == 'Q') && p[1] == '=';
+            if (isQ) {
+                p += 2;
+                zero = true;
+            }
+            for (; *p && *p != ',' && *p != ';'; p++) {
+                if (isQ && *p >= '1' && *p <= '9') zero = false;
+            }
+        }
+        if (match) return !zero;
+    }
+    return false;
+}
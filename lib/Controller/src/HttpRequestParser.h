@@ -0,0 +1,114 @@
+//
+// Incremental HTTP request parser used by Controller's connection table.
+//
+
+#ifndef THEFORGE2026_HTTP_REQUEST_PARSER_H
+#define THEFORGE2026_HTTP_REQUEST_PARSER_H
+
+#include <stdint.h>
+
+// Tokenized view of a request line. All pointers point into the parser's
+// buffer and stay valid until the parser is reset. Query keys and values are
+// already decoded ('+' and %XX), so handlers never copy or allocate.
+struct HttpRequest {
+    static constexpr uint8_t MAX_PARAMS = 8;   // further parameters are ignored
+
+    const char* method = "";
+    const char* path = "";
+    uint8_t paramCount = 0;
+    const char* keys[MAX_PARAMS];
+    const char* values[MAX_PARAMS];
+
+    // Minor version from "HTTP/1.x" (0 when missing or HTTP/1.0)
+    uint8_t httpMinor = 0;
+
+    // From the headers; valid once the parser reports COMPLETE
+    bool acceptsGzip = false;
+    const char* ifNoneMatch = "";   // raw header value, "" when absent
+
+    bool isGet(const char* p) const;
+
+    // If-None-Match lists etag (or is "*"); weak validators compare equal
+    bool etagMatches(const char* etag) const;
+
+    // nullptr when the key is absent
+    const char* param(const char* key) const;
+
+    // Decimal integer with optional sign; false when absent or not a number
+    bool paramInt(const char* key, int& out) const;
+};
+
+// Consumes a request one byte at a time, so the caller can feed whatever the
+// socket has buffered and return immediately. The request line is kept in a
+// fixed buffer and tokenized in place once it is complete; each header line
+// is scanned for the few headers the controller cares about and then
+// discarded.
+class HttpRequestParser {
+public:
+    static constexpr uint16_t MAX_REQUEST_LINE = 256;
+    static constexpr uint8_t MAX_HEADER_LINE = 96;   // longer lines are truncated
+    static constexpr uint8_t MAX_IF_NONE_MATCH = 48; // longer lists never match
+
+    enum State : uint8_t {
+        READ_REQUEST_LINE,
+        READ_HEADERS,
+        COMPLETE,
+        ERROR
+    };
+
+    HttpRequestParser();
+
+    // Forget everything and wait for the next request line
+    void reset();
+
+    // Feed one byte; returns the state after consuming it.
+    // Once COMPLETE or ERROR is reached further bytes are ignored until reset().
+    State feed(char c);
+
+    State state() const { return _state; }
+    bool done() const { return _state == COMPLETE || _state == ERROR; }
+
+    // True once at least one byte of the current request has been seen
+    bool started() const { return _lineLen > 0 || _state != READ_REQUEST_LINE; }
+
+    // Method, path and query parameters; valid from READ_HEADERS on
+    const HttpRequest& request() const { return _request; }
+
+    uint8_t httpMinorVersion() const { return _request.httpMinor; }
+
+    // HTTP/1.1 keeps the connection unless "Connection: close";
+    // HTTP/1.0 only when the client sent "Connection: keep-alive"
+    bool keepAliveRequested() const;
+
+    // "Upgrade: websocket" + "Connection: Upgrade" + a Sec-WebSocket-Key
+    bool webSocketUpgradeRequested() const;
+    const char* webSocketKey() const { return _wsKey; }
+
+private:
+    void parseVersion();
+    void tokenizeRequestLine();
+    void parseHeaderLine();
+
+    static char* decodeInPlace(char* s);
+
+    static bool equalsIgnoreCase(const char* a, uint8_t len, const char* b);
+    static bool hasTokenIgnoreCase(const char* list, const char* token);
+    static bool acceptsCoding(const char* list, const char* coding);
+
+    char _line[MAX_REQUEST_LINE + 1];
+    uint16_t _lineLen;
+    HttpRequest _request;
+
+    char _header[MAX_HEADER_LINE + 1];
+    uint8_t _headerLen;    // bytes stored for the current header line (CR excluded)
+
+    State _state;
+    bool _connClose;
+    bool _connKeepAlive;
+    bool _connUpgrade;
+    bool _upgradeWebSocket;
+    char _wsKey[24 + 1];   // Sec-WebSocket-Key is always 24 base64 chars
+    char _ifNoneMatch[MAX_IF_NONE_MATCH + 1];
+};
+
+#endif // THEFORGE2026_HTTP_REQUEST_PARSER_H
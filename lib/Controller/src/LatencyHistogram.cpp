@@ -0,0 +1,68 @@
+//
+// Fixed-bucket latency histograms for Controller's /metrics endpoint.
+//
+
+#include "LatencyHistogram.h"
+
+uint8_t LatencyHistogram::bucketFor(uint32_t us) {
+    if (us <= 16) return 0;
+
+    // Bucket i holds (16 * 4^(i-1), 16 * 4^i]: compare bit lengths of us - 1
+    uint8_t bits = 0;
+    for (uint32_t v = us - 1; v; v >>= 1) bits++;
+    const uint8_t bucket = (uint8_t)((bits - 3) / 2);
+    return bucket < BOUNDED_BUCKETS ? bucket : BOUNDED_BUCKETS;
+}
+
+void LatencyHistogram::record(uint32_t us) {
+    _buckets[bucketFor(us)]++;
+    _count++;
+    _sumUs += us;
+}
+
+void LatencyHistogram::reset() {
+    for (uint8_t i = 0; i < BUCKETS; i++) _buckets[i] = 0;
+    _count = 0;
+    _sumUs = 0;
+}
+
+static void printSeconds(ResponseWriter& w, uint64_t us) {
+    w.print((long)(us / 1000000UL));
+    w.print('.');
+    uint32_t frac = (uint32_t)(us % 1000000UL);
+    for (uint32_t div = 100000; div; div /= 10) {
+        w.print((char)('0' + (frac / div) % 10));
+    }
+}
+
+static void printSeries(ResponseWriter& w, const char* name, const char* suffix, const char* labels) {
+    w.print(name);
+    w.print(suffix);
+    w.print('{');
+    w.print(labels);
+}
+
+void writePrometheusHistogram(ResponseWriter& w, const char* name, const char* labels,
+                              const LatencyHistogram& h) {
+    uint32_t cumulative = 0;
+    for (uint8_t i = 0; i < LatencyHistogram::BUCKETS; i++) {
+        cumulative += h.bucketCount(i);
+        printSeries(w, name, "_bucket", labels);
+        w.print(",le=\"");
+        if (i < LatencyHistogram::BOUNDED_BUCKETS) printSeconds(w, LatencyHistogram::upperBoundUs(i));
+        else w.print("+Inf");
+        w.print("\"} ");
+        w.print((long)cumulative);
+        w.print('\n');
+    }
+
+    printSeries(w, name, "_sum", labels);
+    w.print("} ");
+    printSeconds(w, h.sumUs());
+    w.print('\n');
+
+    printSeries(w, name, "_count", labels);
+    w.print("} ");
+    w.print((long)h.count());
+    w.print('\n');
+}
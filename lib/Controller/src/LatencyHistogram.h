@@ -0,0 +1,42 @@
+//
+// Fixed-bucket latency histograms for Controller's /metrics endpoint.
+//
+
+#ifndef THEFORGE2026_LATENCY_HISTOGRAM_H
+#define THEFORGE2026_LATENCY_HISTOGRAM_H
+
+#include <stdint.h>
+
+#include "ResponseWriter.h"
+
+// Log-scale buckets in microseconds, a factor of 4 apart: <=16 us, <=64 us,
+// ... <=1.05 s, then overflow. Recording is a bit count and an increment,
+// cheap enough to run around every request phase.
+class LatencyHistogram {
+public:
+    static constexpr uint8_t BOUNDED_BUCKETS = 9;
+    static constexpr uint8_t BUCKETS = BOUNDED_BUCKETS + 1;   // last one is +Inf
+
+    static uint32_t upperBoundUs(uint8_t bucket) { return 16UL << (2 * bucket); }
+    static uint8_t bucketFor(uint32_t us);
+
+    void record(uint32_t us);
+    void reset();
+
+    uint32_t count() const { return _count; }
+    uint64_t sumUs() const { return _sumUs; }
+    uint32_t bucketCount(uint8_t bucket) const { return _buckets[bucket]; }
+
+private:
+    uint32_t _buckets[BUCKETS] = {};
+    uint32_t _count = 0;
+    uint64_t _sumUs = 0;
+};
+
+// One histogram in Prometheus text format: cumulative _bucket lines plus
+// _sum and _count, all in seconds. labels is inserted as-is, e.g.
+// route="drive",phase="handler" (no braces).
+void writePrometheusHistogram(ResponseWriter& w, const char* name, const char* labels,
+                              const LatencyHistogram& h);
+
+#endif // THEFORGE2026_LATENCY_HISTOGRAM_H
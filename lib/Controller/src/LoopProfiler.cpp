@@ -0,0 +1,164 @@
+//
+// Loop period and per-section timing for Controller::update().
+//
+
+#include "LoopProfiler.h"
+
+#include <string.h>
+
+LoopProfiler::LoopProfiler(uint8_t sectionCount)
+    : _sections(sectionCount < MAX_SECTIONS ? sectionCount : MAX_SECTIONS) {
+    reset();
+}
+
+void LoopProfiler::reset() {
+    _started = false;
+    _loops = 0;
+    _minUs = 0;
+    _sumUs = 0;
+    _overruns = 0;
+    memset(_current, 0, sizeof(_current));
+    memset(_hist, 0, sizeof(_hist));
+    memset(_ring, 0, sizeof(_ring));
+    _ringHead = 0;
+    memset(&_worst, 0, sizeof(_worst));
+    memset(&_lastOverrun, 0, sizeof(_lastOverrun));
+}
+
+uint32_t LoopProfiler::loopStart(uint32_t nowUs) {
+    uint32_t period = 0;
+    if (_started) {
+        period = nowUs - _loopStartUs;
+        finishSample(period);
+    }
+    _started = true;
+    _loopStartUs = nowUs;
+    _markUs = nowUs;
+    memset(_current, 0, sizeof(_current));
+    return period;
+}
+
+void LoopProfiler::mark(uint8_t section, uint32_t nowUs) {
+    if (section < _sections) _current[section] += nowUs - _markUs;
+    _markUs = nowUs;
+}
+
+void LoopProfiler::finishSample(uint32_t periodUs) {
+    Sample& s = _ring[_ringHead];
+    _ringHead = (uint8_t)((_ringHead + 1) % RING_SIZE);
+
+    _loops++;
+    s.loop = _loops;
+    s.periodUs = periodUs;
+    uint32_t inside = 0;
+    for (uint8_t i = 0; i < MAX_SECTIONS; i++) {
+        s.sectionUs[i] = _current[i];
+        inside += _current[i];
+    }
+    s.otherUs = periodUs > inside ? periodUs - inside : 0;
+
+    if (_loops == 1 || periodUs < _minUs) _minUs = periodUs;
+    if (periodUs >= _worst.periodUs) _worst = s;
+    _sumUs += periodUs;
+    _hist[histBucket(periodUs)]++;
+
+    if (_budgetUs > 0 && periodUs > _budgetUs) {
+        _overruns++;
+        _lastOverrun = s;
+    }
+}
+
+uint8_t LoopProfiler::histBucket(uint32_t us) {
+    if (us < 16) return 0;
+
+    uint8_t msb = 31;
+    while (!(us & (1UL << msb))) msb--;
+    if (msb >= 4 + OCTAVES) return HIST_BUCKETS - 1;
+
+    // Two bits below the leading one pick the quarter of the octave
+    const uint8_t sub = (uint8_t)((us >> (msb - 2)) & 3);
+    return (uint8_t)(1 + (msb - 4) * 4 + sub);
+}
+
+uint32_t LoopProfiler::histUpperUs(uint8_t bucket) {
+    if (bucket == 0) return 15;
+    if (bucket >= HIST_BUCKETS - 1) return 0xFFFFFFFFUL;
+
+    const uint8_t octave = (uint8_t)((bucket - 1) / 4 + 4);
+    const uint8_t sub = (uint8_t)((bucket - 1) % 4);
+    return (1UL << octave) + ((uint32_t)(sub + 1) << (octave - 2)) - 1;
+}
+
+uint32_t LoopProfiler::percentileUs(uint8_t pct) const {
+    if (_loops == 0) return 0;
+
+    const uint32_t rank = (uint32_t)(((uint64_t)_loops * pct + 99) / 100);
+    uint32_t seen = 0;
+    for (uint8_t i = 0; i < HIST_BUCKETS; i++) {
+        seen += _hist[i];
+        if (seen >= rank) {
+            // Never report more than the worst loop actually seen
+            const uint32_t upper = histUpperUs(i);
+            return upper < _worst.periodUs ? upper : _worst.periodUs;
+        }
+    }
+    return _worst.periodUs;
+}
+
+void LoopProfiler::writeSample(ResponseWriter& w, const Sample& s, uint8_t sections) {
+    w.print('#');
+    w.print((long)s.loop);
+    w.print(' ');
+    w.print((long)s.periodUs);
+    for (uint8_t i = 0; i < sections; i++) {
+        w.print(' ');
+        w.print((long)s.sectionUs[i]);
+    }
+    w.print(' ');
+    w.print((long)s.otherUs);
+    w.print('\n');
+}
+
+void LoopProfiler::writeSummary(ResponseWriter& w, const char* const* names) const {
+    // loops=.. min=.. mean=.. p99=.. max=.. budget=.. overruns=..
+    w.print("loops=");
+    w.print((long)_loops);
+    w.print(" min=");
+    w.print((long)minUs());
+    w.print("us mean=");
+    w.print((long)meanUs());
+    w.print("us p99=");
+    w.print((long)percentileUs(99));
+    w.print("us max=");
+    w.print((long)maxUs());
+    w.print("us budget=");
+    w.print((long)_budgetUs);
+    w.print("us overruns=");
+    w.print((long)_overruns);
+    w.print('\n');
+
+    // Breakdown columns, in microseconds
+    w.print("columns: loop period");
+    for (uint8_t i = 0; i < _sections; i++) {
+        w.print(' ');
+        w.print(names[i]);
+    }
+    w.print(" sketch\n");
+
+    if (_loops == 0) return;
+
+    w.print("worst: ");
+    writeSample(w, _worst, _sections);
+    if (_overruns) {
+        w.print("last overrun: ");
+        writeSample(w, _lastOverrun, _sections);
+    }
+
+    // Recent loops, oldest first
+    w.print("recent:\n");
+    for (uint8_t n = 0; n < RING_SIZE; n++) {
+        const Sample& s = _ring[(_ringHead + n) % RING_SIZE];
+        if (s.loop == 0) continue;
+        writeSample(w, s, _sections);
+    }
+}
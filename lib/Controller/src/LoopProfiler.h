@@ -0,0 +1,87 @@
+//
+// Loop period and per-section timing for Controller::update().
+//
+
+#ifndef THEFORGE2026_LOOP_PROFILER_H
+#define THEFORGE2026_LOOP_PROFILER_H
+
+#include <stdint.h>
+
+#include "ResponseWriter.h"
+
+// Times the gap between successive update() calls (the sketch's loop period)
+// and how long each section of update() took within it. Timestamps are
+// passed in (micros()), so this has no Arduino dependency.
+//
+// Period statistics cover everything since reset(). The p99 comes from a
+// histogram with 4 sub-buckets per power of two, so it is an upper bound
+// within 25%. The last RING_SIZE loops are kept with their breakdown, as
+// are the worst loop and the most recent over-budget loop.
+class LoopProfiler {
+public:
+    static constexpr uint8_t MAX_SECTIONS = 6;
+    static constexpr uint8_t RING_SIZE = 16;
+
+    struct Sample {
+        uint32_t loop;                       // loop number since reset()
+        uint32_t periodUs;
+        uint32_t sectionUs[MAX_SECTIONS];    // time inside update(), per section
+        uint32_t otherUs;                    // rest of the period: the sketch
+    };
+
+    explicit LoopProfiler(uint8_t sectionCount);
+
+    // 0 disables overrun tracking
+    void setBudgetUs(uint32_t us) { _budgetUs = us; }
+    uint32_t budgetUs() const { return _budgetUs; }
+
+    // Call first thing in update(); returns the period that just ended (0 on
+    // the first call)
+    uint32_t loopStart(uint32_t nowUs);
+
+    // Close the section that has been running since the previous mark
+    void mark(uint8_t section, uint32_t nowUs);
+
+    void reset();
+
+    uint32_t loops() const { return _loops; }
+    uint32_t minUs() const { return _loops ? _minUs : 0; }
+    uint32_t maxUs() const { return _worst.periodUs; }
+    uint32_t meanUs() const { return _loops ? (uint32_t)(_sumUs / _loops) : 0; }
+    uint32_t percentileUs(uint8_t pct) const;
+    uint32_t overruns() const { return _overruns; }
+
+    // Compact text summary; names has one entry per section
+    void writeSummary(ResponseWriter& w, const char* const* names) const;
+
+private:
+    // Histogram: values < 16 us, then 4 buckets per octave up to 2^24 us
+    static constexpr uint8_t OCTAVES = 20;
+    static constexpr uint8_t HIST_BUCKETS = 1 + OCTAVES * 4 + 1;
+    static uint8_t histBucket(uint32_t us);
+    static uint32_t histUpperUs(uint8_t bucket);
+
+    void finishSample(uint32_t periodUs);
+    static void writeSample(ResponseWriter& w, const Sample& s, uint8_t sections);
+
+    uint8_t _sections;
+    uint32_t _budgetUs = 0;
+
+    bool _started = false;
+    uint32_t _loopStartUs = 0;
+    uint32_t _markUs = 0;
+    uint32_t _current[MAX_SECTIONS];
+
+    uint32_t _loops = 0;
+    uint32_t _minUs = 0;
+    uint64_t _sumUs = 0;
+    uint32_t _overruns = 0;
+    uint32_t _hist[HIST_BUCKETS];
+
+    Sample _ring[RING_SIZE];
+    uint8_t _ringHead = 0;      // next slot to write
+    Sample _worst;
+    Sample _lastOverrun;
+};
+
+#endif // THEFORGE2026_LOOP_PROFILER_H
@@ -0,0 +1,110 @@
+//
+// Per-wheel output ramping for Controller, driven by elapsed time.
+//
+
+#include "MotionProfile.h"
+
+void SlewLimiter::setRates(uint16_t accel, uint16_t decel, uint16_t brake) {
+    _accel = accel;
+    _decel = decel;
+    _brake = brake;
+}
+
+// floor(sqrt(v)), bit by bit
+static uint32_t isqrt64(uint64_t v) {
+    uint64_t root = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+    while (bit > v) bit >>= 2;
+    while (bit) {
+        if (v >= root + bit) {
+            v -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)root;
+}
+
+int8_t SlewLimiter::step(int8_t target, uint32_t dtUs) {
+    if (dtUs > MAX_STEP_US) dtUs = MAX_STEP_US;
+
+    const int32_t goal = (int32_t)target * SCALE;
+    const int32_t delta = goal - _value;
+    if (delta == 0) {
+        _rate = 0;
+        _carry = 0;
+        return output();
+    }
+
+    // Stick released or failsafe: always the straight, fast ramp
+    if (target == 0) return stepLinear(goal, _brake, dtUs);
+
+    // Moving away from zero speeds up; anything else slows down
+    const bool growing = (_value >= 0 && delta > 0) || (_value <= 0 && delta < 0);
+    const uint16_t rate = growing ? _accel : _decel;
+
+    if (_jerk == 0) return stepLinear(goal, rate, dtUs);
+    return stepSCurve(goal, rate, dtUs);
+}
+
+int8_t SlewLimiter::stepLinear(int32_t goal, uint16_t rate, uint32_t dtUs) {
+    const int32_t delta = goal - _value;
+    _carry = 0;
+
+    // units/s * us -> thousandths of a unit: rate * dt / 1000
+    const int32_t maxStep = (int32_t)(((uint64_t)rate * dtUs) / 1000);
+
+    if (delta > maxStep) {
+        _value += maxStep;
+        _rate = (int32_t)rate * SCALE;
+    } else if (delta < -maxStep) {
+        _value -= maxStep;
+        _rate = -(int32_t)rate * SCALE;
+    } else {
+        _value = goal;
+        _rate = 0;
+    }
+    return output();
+}
+
+int8_t SlewLimiter::stepSCurve(int32_t goal, uint16_t rate, uint32_t dtUs) {
+    const int32_t delta = goal - _value;
+    const uint32_t distance = (uint32_t)(delta < 0 ? -delta : delta);
+
+    // Fastest rate that can still be ramped down to zero over the remaining
+    // distance at the jerk limit: v = sqrt(2 * j * d), internal units
+    const uint32_t jerk = (uint32_t)_jerk * SCALE;
+    uint32_t limit = isqrt64(2ULL * jerk * distance);
+    if (limit > (uint32_t)rate * SCALE) limit = (uint32_t)rate * SCALE;
+    const int32_t want = delta > 0 ? (int32_t)limit : -(int32_t)limit;
+
+    // Move the rate toward it by at most jerk * dt
+    const int32_t maxRateStep = (int32_t)(((uint64_t)jerk * dtUs) / 1000000);
+    const int32_t rateDelta = want - _rate;
+    if (rateDelta > maxRateStep) _rate += maxRateStep;
+    else if (rateDelta < -maxRateStep) _rate -= maxRateStep;
+    else _rate = want;
+
+    // Keep the sub-unit remainder so short periods do not lose distance
+    const int64_t travel = (int64_t)_rate * (int64_t)dtUs + _carry;
+    const int32_t move = (int32_t)(travel / 1000000);
+    _carry = (int32_t)(travel % 1000000);
+
+    // Land on the goal instead of stepping past it
+    if ((delta > 0 && move >= delta) || (delta < 0 && move <= delta)) {
+        _value = goal;
+        _rate = 0;
+        _carry = 0;
+    } else {
+        _value += move;
+    }
+    return output();
+}
+
+int8_t SlewLimiter::output() const {
+    // Round half away from zero so the ramp ends exactly on the target
+    const int32_t half = SCALE / 2;
+    return (int8_t)((_value >= 0 ? _value + half : _value - half) / SCALE);
+}
@@ -0,0 +1,56 @@
+//
+// Per-wheel output ramping for Controller, driven by elapsed time.
+//
+
+#ifndef THEFORGE2026_MOTION_PROFILE_H
+#define THEFORGE2026_MOTION_PROFILE_H
+
+#include <stdint.h>
+
+// Rate-limits one output (-100..100) toward its target. Rates are in units
+// per second and the step is computed from the elapsed time, so the ramp is
+// the same whether update() runs at 50 Hz or 5 kHz. The output is kept in
+// thousandths of a unit so slow rates on fast loops still make progress.
+//
+//   accel: magnitude growing (speeding up in the current direction)
+//   decel: magnitude shrinking toward a non-zero target (or through zero)
+//   brake: target is zero (released stick or failsafe)
+//
+// With a jerk limit set, accel and decel become the peak rate of an S-curve:
+// the rate of change itself ramps up and down at the jerk limit (units per
+// second squared), and eases off early enough to land on the target without
+// overshoot. Braking stays a straight ramp at the brake rate.
+class SlewLimiter {
+public:
+    static constexpr int32_t SCALE = 1000;          // internal units per output unit
+    static constexpr uint32_t MAX_STEP_US = 100000; // a stall ramps at most 100 ms worth
+
+    void setRates(uint16_t accel, uint16_t decel, uint16_t brake);
+
+    // 0 (default): plain rate limit; otherwise S-curve ramps
+    void setJerk(uint16_t unitsPerSec2) { _jerk = unitsPerSec2; }
+
+    // Advance by dtUs toward target; returns the new output
+    int8_t step(int8_t target, uint32_t dtUs);
+
+    int8_t output() const;
+    void reset(int8_t value = 0) {
+        _value = (int32_t)value * SCALE;
+        _rate = 0;
+        _carry = 0;
+    }
+
+private:
+    int8_t stepLinear(int32_t goal, uint16_t rate, uint32_t dtUs);
+    int8_t stepSCurve(int32_t goal, uint16_t rate, uint32_t dtUs);
+
+    uint16_t _accel = 400;
+    uint16_t _decel = 800;
+    uint16_t _brake = 1500;
+    uint16_t _jerk = 0;
+    int32_t _value = 0;
+    int32_t _rate = 0;   // current rate of change, internal units per second
+    int32_t _carry = 0;  // S-curve travel below one internal unit, in unit-microseconds
+};
+
+#endif // THEFORGE2026_MOTION_PROFILE_H
@@ -0,0 +1,172 @@
+//
+// Compile-time motor driver backends for Controller (L298N, TB6612FNG, DRV8833).
+//
+
+#ifndef THEFORGE2026_MOTOR_DRIVER_H
+#define THEFORGE2026_MOTOR_DRIVER_H
+
+#include <Arduino.h>
+
+#include "FastGpio.h"
+#include "MotorPwm.h"
+
+// A driver policy describes one kind of H-bridge:
+//
+//   struct Channel { ... };                 pins of one motor
+//   void enable(bool on);                   driver-wide enable (standby pin)
+//   void begin(Channel& ch);                pins to outputs, motor braked
+//   void write(Channel& ch, int8_t speed, uint16_t duty);
+//                                           speed -100..100 picks the
+//                                           direction, duty (0..0xFFFF) is
+//                                           the PWM for |speed|
+//
+// MotorDriver<Policy, N> owns N channels and is handed to
+// Controller::attachMotorDriver(). Every call below is resolved at compile
+// time; the controller reaches the driver through one plain function
+// pointer per control step.
+
+// -------------------- MotorDriver --------------------
+
+template <typename Policy, uint8_t N>
+class MotorDriver {
+public:
+    using Channel = typename Policy::Channel;
+    static constexpr uint8_t CHANNELS = N;
+
+    MotorDriver() = default;
+    MotorDriver(const Channel (&channels)[N], Policy policy = Policy()) : _policy(policy) {
+        for (uint8_t i = 0; i < N; i++) _channels[i] = channels[i];
+    }
+
+    void setChannel(uint8_t i, const Channel& ch) {
+        if (i < N) _channels[i] = ch;
+    }
+    Policy& policy() { return _policy; }
+
+    void begin() {
+        for (uint8_t i = 0; i < N; i++) _policy.begin(_channels[i]);
+        _policy.enable(true);
+    }
+
+    void write(uint8_t i, int8_t speed, uint16_t duty) {
+        if (i < N) _policy.write(_channels[i], speed, duty);
+    }
+
+    // Controller entry points (ctx is the driver)
+    static void beginThunk(void* ctx) {
+        static_cast<MotorDriver*>(ctx)->begin();
+    }
+
+    // speeds[0..count) -100..100; dutyTable maps |speed| to duty (101 entries)
+    static void applyThunk(void* ctx, const int8_t* speeds, const uint16_t* dutyTable, uint8_t count) {
+        MotorDriver* self = static_cast<MotorDriver*>(ctx);
+        if (count > N) count = N;
+        for (uint8_t i = 0; i < count; i++) {
+            const int s = speeds[i];
+            const uint8_t mag = (uint8_t)(s < 0 ? -s : s);
+            self->_policy.write(self->_channels[i], speeds[i], dutyTable[mag > 100 ? 100 : mag]);
+        }
+    }
+
+private:
+    Policy _policy;
+    Channel _channels[N] = {};
+};
+
+// -------------------- Policies --------------------
+
+// Direction on two inputs, speed as PWM on the enable pin.
+// Zero drives both inputs high: brake, which stops faster than coasting.
+// Both inputs change in one port write (see FastGpio.h). pwmHz other than
+// 0 runs the enable pins from GPT timers at that frequency (see MotorPwm.h).
+struct L298N {
+    struct Channel {
+        uint8_t en;
+        uint8_t inA;
+        uint8_t inB;
+        DirectionPins dir;   // filled by begin()
+        FastPwmPin pwm;      // filled by begin()
+    };
+
+    uint32_t pwmHz = 0;      // 0: analogWrite()
+
+    void enable(bool) {}
+
+    void begin(Channel& ch) {
+        ch.dir.begin(ch.inA, ch.inB);
+        ch.pwm.begin(ch.en, pwmHz);
+        write(ch, 0, 0);
+    }
+
+    void write(Channel& ch, int8_t speed, uint16_t duty) {
+        ch.dir.write(speed >= 0, speed <= 0);
+        ch.pwm.write(speed == 0 ? 0 : duty);
+    }
+};
+
+// Same wiring per channel as the L298N (IN1/IN2 + PWM), plus one STBY pin
+// for the whole chip that must be high for the outputs to work.
+struct TB6612 {
+    struct Channel {
+        uint8_t pwm;
+        uint8_t in1;
+        uint8_t in2;
+        DirectionPins dir;   // filled by begin()
+        FastPwmPin out;      // filled by begin()
+    };
+
+    uint8_t standby = 255;   // 255: STBY tied high on the board
+    uint32_t pwmHz = 0;      // 0: analogWrite(); the TB6612 takes up to 100 kHz
+
+    void enable(bool on) {
+        if (standby == 255) return;
+        pinMode(standby, OUTPUT);
+        digitalWrite(standby, on ? HIGH : LOW);
+    }
+
+    void begin(Channel& ch) {
+        ch.dir.begin(ch.in1, ch.in2);
+        ch.out.begin(ch.pwm, pwmHz);
+        write(ch, 0, 0);
+    }
+
+    void write(Channel& ch, int8_t speed, uint16_t duty) {
+        // Zero: short brake (both inputs high)
+        ch.dir.write(speed >= 0, speed <= 0);
+        ch.out.write(speed == 0 ? 0 : duty);
+    }
+};
+
+// Two PWM inputs per channel and no enable pin. One input carries the duty
+// and the other stays low (fast decay); both high is brake.
+struct DRV8833 {
+    struct Channel {
+        uint8_t in1;
+        uint8_t in2;
+    };
+
+    void enable(bool) {}
+
+    void begin(Channel& ch) {
+        pinMode(ch.in1, OUTPUT);
+        pinMode(ch.in2, OUTPUT);
+        write(ch, 0, 0);
+    }
+
+    void write(Channel& ch, int8_t speed, uint16_t duty) {
+        // analogWrite() takes the top 8 bits
+        const uint8_t pwm = duty >> 8;
+        if (speed == 0) {
+            analogWrite(ch.in1, 255);
+            analogWrite(ch.in2, 255);
+        } else if (speed > 0) {
+            analogWrite(ch.in1, pwm);
+            analogWrite(ch.in2, 0);
+        } else {
+            analogWrite(ch.in1, 0);
+            analogWrite(ch.in2, pwm);
+        }
+    }
+};
+
+#endif // THEFORGE2026_MOTOR_DRIVER_H
@@ -0,0 +1,83 @@
+//
+// High-frequency motor PWM on GPT timer outputs (Renesas RA).
+//
+
+#ifndef THEFORGE2026_MOTOR_PWM_H
+#define THEFORGE2026_MOTOR_PWM_H
+
+#include <Arduino.h>
+
+#include "GptPwm.h"
+
+// One PWM pin for an H-bridge enable input. analogWrite() runs at about
+// 490 Hz with 8-bit duty, which motors hear as a whine and which leaves
+// low speeds rough. begin() with a frequency instead finds the GPT channel
+// and output (A/B) behind the pin, the same way the core's PwmOut does,
+// and sets the timer up through GptPwm.h: 20 kHz from the 48 MHz PCLKD is
+// 2400 counts per period (11 bits), and the 16-bit duty is scaled to that
+// without passing through 8 bits. write() only stores the next compare
+// value in the buffer register, so it is safe from the control timer ISR
+// and a period is never cut short.
+//
+// With hz 0, a pin without a GPT output, or on other boards write() falls
+// back to analogWrite(). Don't analogWrite() the other pin of the same GPT
+// channel: both outputs share one period.
+class FastPwmPin {
+public:
+    bool begin(uint8_t pin, uint32_t hz) {
+        _pin = pin;
+        _period = 0;
+        pinMode(pin, OUTPUT);
+        if (hz == 0) return false;
+#if defined(ARDUINO_ARCH_RENESAS)
+        const auto cfg = getPinCfgs(pin, PIN_CFG_REQ_PWM);
+        if (cfg[0] == 0 || IS_PIN_AGT_PWM(cfg[0])) return false;
+
+        const uint8_t channel = GET_CHANNEL(cfg[0]);
+        const uint32_t counterMax = channel < GPT_32BIT_CHANNELS ? 0xFFFFFFFFUL : 0xFFFFUL;
+        GptPwmTiming timing;
+        if (!gptPwmTiming(R_FSP_SystemClockHzGet(FSP_PRIV_CLOCK_PCLKD), hz, counterMax, timing)) {
+            return false;
+        }
+
+        R_BSP_MODULE_START(FSP_IP_GPT, channel);
+        _regs = (R_GPT0_Type*)((uintptr_t)R_GPT0 + ((uintptr_t)R_GPT1 - (uintptr_t)R_GPT0) * channel);
+        _outputA = IS_PWM_ON_A(cfg[0]);
+        gptPwmConfigure(*_regs, timing, _outputA);
+        R_IOPORT_PinCfg(&g_ioport_ctrl, g_pin_cfg[pin].pin,
+                        (uint32_t)(IOPORT_CFG_PERIPHERAL_PIN | IOPORT_PERIPHERAL_GPT1));
+        _period = timing.periodCounts;
+        _bits = timing.resolutionBits;
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    // duty 0..0xFFFF (see buildPwmTable())
+    void write(uint16_t duty) {
+#if defined(ARDUINO_ARCH_RENESAS)
+        if (_period) {
+            gptPwmSetDuty(*_regs, _outputA, gptDutyCounts(duty, _period), _period);
+            return;
+        }
+#endif
+        analogWrite(_pin, duty >> 8);
+    }
+
+    bool active() const { return _period != 0; }
+    uint8_t resolutionBits() const { return _period ? _bits : 8; }
+
+private:
+#if defined(ARDUINO_ARCH_RENESAS)
+    static constexpr uint8_t GPT_32BIT_CHANNELS = 2;   // GPT320/321; the rest are 16-bit
+
+    R_GPT0_Type* _regs = nullptr;
+    bool _outputA = true;
+#endif
+    uint8_t _pin = 0;
+    uint8_t _bits = 8;
+    uint32_t _period = 0;   // 0: analogWrite()
+};
+
+#endif // THEFORGE2026_MOTOR_PWM_H
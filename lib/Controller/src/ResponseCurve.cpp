@@ -0,0 +1,42 @@
+//
+// Lookup tables for stick response curves and motor PWM scaling.
+//
+
+#include "ResponseCurve.h"
+
+// Built at compile time and kept in flash
+static constexpr CurveTable CURVE_TABLES[CURVE_COUNT] = {
+    makeExpoCurve(0),
+    makeExpoCurve(50),
+    makeExpoCurve(100)
+};
+
+static_assert(CURVE_TABLES[CURVE_LINEAR](-37) == -37, "linear curve is the identity");
+static_assert(CURVE_TABLES[CURVE_CUBIC](50) == 13, "cubic: 0.5^3 = 0.125");
+
+void buildInputCurve(ResponseCurve curve, uint8_t deadband, CurveTable& out) {
+    if (curve >= CURVE_COUNT) curve = CURVE_LINEAR;
+    if (deadband > 50) deadband = 50;
+
+    const CurveTable& base = CURVE_TABLES[curve];
+    const int span = 100 - deadband;
+
+    for (int x = -100; x <= 100; x++) {
+        const int mag = x < 0 ? -x : x;
+        int scaled = 0;
+        if (mag >= deadband && mag > 0) {
+            // deadband..100 -> 0..100, rounded
+            scaled = ((mag - deadband) * 100 + span / 2) / span;
+        }
+        out.v[x + 100] = base(x < 0 ? -scaled : scaled);
+    }
+}
+
+void buildPwmTable(uint8_t minPwm, uint16_t out[101]) {
+    // 8-bit minimum to 16 bits: 255 * 257 = 0xFFFF
+    const uint32_t minDuty = (uint32_t)minPwm * 257;
+    out[0] = 0;
+    for (uint32_t s = 1; s <= 100; s++) {
+        out[s] = (uint16_t)(minDuty + (s * (MOTOR_DUTY_MAX - minDuty) + 50) / 100);
+    }
+}
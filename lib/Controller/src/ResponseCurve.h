@@ -0,0 +1,53 @@
+//
+// Lookup tables for stick response curves and motor PWM scaling.
+//
+
+#ifndef THEFORGE2026_RESPONSE_CURVE_H
+#define THEFORGE2026_RESPONSE_CURVE_H
+
+#include <stdint.h>
+
+static constexpr uint8_t CURVE_SIZE = 201;   // one entry per input, index v + 100
+
+enum ResponseCurve : uint8_t {
+    CURVE_LINEAR,   // output = input
+    CURVE_EXPO,     // half linear, half cubic: finer control near center
+    CURVE_CUBIC,    // output = input^3: finest low-speed control
+    CURVE_COUNT
+};
+
+struct CurveTable {
+    int8_t v[CURVE_SIZE];
+
+    // x must already be in -100..100
+    constexpr int8_t operator()(int x) const { return v[x + 100]; }
+};
+
+// out = (1 - k) * x + k * x^3, with k = cubicPercent / 100 and x in -1..1,
+// rounded half away from zero
+constexpr CurveTable makeExpoCurve(uint8_t cubicPercent) {
+    CurveTable t{};
+    for (int x = -100; x <= 100; x++) {
+        const long k = cubicPercent;
+        const long num = (100 - k) * x * 10000L + k * x * x * x;   // scaled by 1e6
+        const long half = 500000L;
+        t.v[x + 100] = (int8_t)((num >= 0 ? num + half : num - half) / 1000000L);
+    }
+    return t;
+}
+
+// Curve with a deadband folded in: inputs inside +/-deadband give 0 and the
+// rest of the stick is stretched over the whole curve, so there is no jump
+// from 0 to deadband at the edge. deadband is limited to 50.
+void buildInputCurve(ResponseCurve curve, uint8_t deadband, CurveTable& out);
+
+// Full duty in the motor path. Duty is carried as 16 bits so a fine timer
+// (MotorPwm.h) gets every speed step; analogWrite() uses the top 8 bits.
+static constexpr uint16_t MOTOR_DUTY_MAX = 0xFFFF;
+
+// Speed 0..100 to duty 0..MOTOR_DUTY_MAX. Non-zero speeds start at minPwm
+// (0..255, the analogWrite() scale) and scale up to full duty, instead of
+// every low speed being clamped to minPwm.
+void buildPwmTable(uint8_t minPwm, uint16_t out[101]);
+
+#endif // THEFORGE2026_RESPONSE_CURVE_H
@@ -0,0 +1,189 @@
+//
+// Buffered HTTP response builder: coalesces status line, headers and body
+// into as few socket writes as possible.
+//
+
+#include "ResponseWriter.h"
+
+#include <string.h>
+
+ResponseWriter::ResponseWriter(uint8_t* buf, uint16_t capacity, SinkFn sink, void* ctx)
+    : _buf(buf), _capacity(capacity), _sink(sink), _ctx(ctx) {}
+
+void ResponseWriter::status(uint16_t code, const char* reason) {
+    print("HTTP/1.1 ");
+    print((long)code);
+    print(' ');
+    print(reason);
+    print("\r\n");
+}
+
+void ResponseWriter::header(const char* name, const char* value) {
+    print(name);
+    print(": ");
+    print(value);
+    print("\r\n");
+}
+
+void ResponseWriter::header(const char* name, unsigned long value) {
+    print(name);
+    print(": ");
+    print((long)value);
+    print("\r\n");
+}
+
+void ResponseWriter::endHeaders() {
+    print("\r\n");
+}
+
+uint16_t ResponseWriter::room() const {
+    const uint16_t end = _chunked ? (uint16_t)(_capacity - CHUNK_SUFFIX) : _capacity;
+    return (_len < end) ? (uint16_t)(end - _len) : 0;
+}
+
+void ResponseWriter::write(const uint8_t* data, size_t len) {
+    // Fits: just append
+    if (len <= room()) {
+        memcpy(_buf + _len, data, len);
+        _len += (uint16_t)len;
+        return;
+    }
+
+    if (_chunked) {
+        writeChunkedDirect(data, len);
+        return;
+    }
+
+    // Top up the buffer so the first transfer is full, then send the rest
+    // directly instead of copying it through the buffer piece by piece
+    const uint16_t room = (uint16_t)(_capacity - _len);
+    memcpy(_buf + _len, data, room);
+    _len = _capacity;
+    data += room;
+    len -= room;
+    flush();
+
+    if (len >= _capacity) {
+        emit(data, len);
+        return;
+    }
+    memcpy(_buf, data, len);
+    _len = (uint16_t)len;
+}
+
+void ResponseWriter::print(const char* s) {
+    write((const uint8_t*)s, strlen(s));
+}
+
+void ResponseWriter::print(char c) {
+    if (room() == 0) flush();
+    _buf[_len++] = (uint8_t)c;
+}
+
+void ResponseWriter::print(long v) {
+    char tmp[12];
+    uint8_t n = 0;
+    unsigned long u = (v < 0) ? (unsigned long)(-(v + 1)) + 1 : (unsigned long)v;
+    do {
+        tmp[n++] = (char)('0' + (u % 10));
+        u /= 10;
+    } while (u);
+    if (v < 0) tmp[n++] = '-';
+
+    // Digits were produced in reverse
+    while (n) print(tmp[--n]);
+}
+
+void ResponseWriter::beginChunked() {
+    _chunked = true;
+    _chunkStart = _len;
+    _len += CHUNK_PREFIX;
+}
+
+void ResponseWriter::writeChunkedDirect(const uint8_t* data, size_t len) {
+    // Top up and send the current chunk, like the plain path
+    const uint16_t top = room();
+    memcpy(_buf + _len, data, top);
+    _len += top;
+    data += top;
+    len -= top;
+    flushChunk(false);
+
+    // Small remainders are buffered into the next chunk
+    if (len <= room()) {
+        memcpy(_buf + _len, data, len);
+        _len += (uint16_t)len;
+        return;
+    }
+
+    // Big remainders become one chunk sent from the caller's memory; its
+    // closing CRLF leads the next buffered transfer
+    static const char hex[] = "0123456789abcdef";
+    char prefix[10];
+    uint8_t n = 0;
+    for (int8_t shift = 28; shift >= 0; shift -= 4) prefix[n++] = hex[(len >> shift) & 0xF];
+    prefix[n++] = '\r';
+    prefix[n++] = '\n';
+    emit((const uint8_t*)prefix, n);
+    emit(data, len);
+
+    _buf[0] = '\r';
+    _buf[1] = '\n';
+    _chunkStart = 2;
+    _len = _chunkStart + CHUNK_PREFIX;
+}
+
+void ResponseWriter::flushChunk(bool last) {
+    static const char hex[] = "0123456789abcdef";
+    const uint16_t dataLen = (uint16_t)(_len - _chunkStart - CHUNK_PREFIX);
+
+    if (dataLen == 0) {
+        // Nothing framed yet: drop the reserved prefix
+        _len = _chunkStart;
+    } else {
+        // Fixed-width size keeps the prefix in place (leading zeros are legal)
+        uint8_t* p = _buf + _chunkStart;
+        p[0] = (uint8_t)hex[(dataLen >> 12) & 0xF];
+        p[1] = (uint8_t)hex[(dataLen >> 8) & 0xF];
+        p[2] = (uint8_t)hex[(dataLen >> 4) & 0xF];
+        p[3] = (uint8_t)hex[dataLen & 0xF];
+        p[4] = '\r';
+        p[5] = '\n';
+        _buf[_len++] = '\r';
+        _buf[_len++] = '\n';
+    }
+
+    if (last) {
+        memcpy(_buf + _len, "0\r\n\r\n", 5);
+        _len += 5;
+    }
+
+    if (_len) emit(_buf, _len);
+    _chunkStart = 0;
+    _len = last ? 0 : CHUNK_PREFIX;
+}
+
+void ResponseWriter::flush() {
+    if (_chunked) {
+        flushChunk(false);
+        return;
+    }
+    if (_len == 0) return;
+    emit(_buf, _len);
+    _len = 0;
+}
+
+void ResponseWriter::finish() {
+    if (_chunked) {
+        flushChunk(true);
+        _chunked = false;
+        return;
+    }
+    flush();
+}
+
+void ResponseWriter::emit(const uint8_t* data, size_t len) {
+    _sink(_ctx, data, len);
+    _sinkWrites++;
+    _bytesWritten += (uint32_t)len;
+}
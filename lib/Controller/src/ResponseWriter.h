@@ -0,0 +1,74 @@
+//
+// Buffered HTTP response builder: coalesces status line, headers and body
+// into as few socket writes as possible.
+//
+
+#ifndef THEFORGE2026_RESPONSE_WRITER_H
+#define THEFORGE2026_RESPONSE_WRITER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// On the Uno R4 every WiFiClient write is a separate transfer to the ESP32-S3
+// bridge, so a response is assembled in a caller-provided buffer and handed
+// to the sink in large pieces. Data larger than the free space is sent
+// straight from the caller's memory (e.g. a flash asset) after one flush.
+//
+// After beginChunked() the body is framed with Transfer-Encoding: chunked,
+// one chunk per flush, so generated content of unknown length streams
+// through the same fixed buffer.
+class ResponseWriter {
+public:
+    // Returns the number of bytes accepted; ctx is passed through untouched
+    typedef size_t (*SinkFn)(void* ctx, const uint8_t* data, size_t len);
+
+    ResponseWriter(uint8_t* buf, uint16_t capacity, SinkFn sink, void* ctx);
+
+    // "HTTP/1.1 <code> <reason>"
+    void status(uint16_t code, const char* reason);
+    void header(const char* name, const char* value);
+    void header(const char* name, unsigned long value);
+    void endHeaders();
+
+    void write(const uint8_t* data, size_t len);
+    void print(const char* s);
+    void print(char c);
+    void print(int v) { print((long)v); }
+    void print(long v);
+
+    // Call right after endHeaders() when the headers announced chunked
+    void beginChunked();
+    bool chunked() const { return _chunked; }
+
+    // Hand everything buffered to the sink (one chunk when chunked)
+    void flush();
+
+    // Last call for a response: flush, plus the terminating chunk if chunked
+    void finish();
+
+    // Sink calls made so far (one per modem transfer on the board)
+    uint16_t sinkWrites() const { return _sinkWrites; }
+    uint32_t bytesWritten() const { return _bytesWritten; }
+
+private:
+    // Chunk framing: "XXXX\r\n" before the data, "\r\n" + "0\r\n\r\n" after
+    static constexpr uint8_t CHUNK_PREFIX = 6;
+    static constexpr uint8_t CHUNK_SUFFIX = 7;
+
+    uint16_t room() const;
+    void writeChunkedDirect(const uint8_t* data, size_t len);
+    void flushChunk(bool last);
+    void emit(const uint8_t* data, size_t len);
+
+    uint8_t* _buf;
+    uint16_t _capacity;
+    uint16_t _len = 0;
+    bool _chunked = false;
+    uint16_t _chunkStart = 0;   // where the current chunk's size prefix begins
+    SinkFn _sink;
+    void* _ctx;
+    uint16_t _sinkWrites = 0;
+    uint32_t _bytesWritten = 0;
+};
+
+#endif // THEFORGE2026_RESPONSE_WRITER_H
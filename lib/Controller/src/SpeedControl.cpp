@@ -0,0 +1,99 @@
+//
+// Quadrature decoding and per-wheel speed PID for Controller's closed loop.
+//
+
+#include "SpeedControl.h"
+
+// -------------------- QuadratureDecoder --------------------
+
+void QuadratureDecoder::update(uint8_t ab) {
+    // Index: previous AB << 2 | current AB. Gray-code steps count +/-1,
+    // positive when A leads B.
+    static const int8_t kStep[16] = {
+         0, -1,  1,  0,
+         1,  0,  0, -1,
+        -1,  0,  0,  1,
+         0,  1, -1,  0
+    };
+    ab &= 3;
+    _count = _count + kStep[(_state << 2) | ab];
+    _state = ab;
+}
+
+// -------------------- WheelSpeedController --------------------
+
+static int32_t clamp32(int32_t v, int32_t lo, int32_t hi) {
+    if (v < lo) return lo;
+    if (v > hi) return hi;
+    return v;
+}
+
+void WheelSpeedController::setGains(int32_t kp, int32_t ki, int32_t kd) {
+    _kp = kp;
+    _ki = ki;
+    _kd = kd;
+    _integral = 0;
+}
+
+void WheelSpeedController::reset() {
+    _primed = false;
+    _elapsedUs = 0;
+    _measured = 0;
+    _integral = 0;
+    _output = 0;
+}
+
+int8_t WheelSpeedController::step(int8_t setpoint, int32_t encoderCount, uint32_t dtUs) {
+    if (!_primed) {
+        _primed = true;
+        _lastCount = encoderCount;
+        _elapsedUs = 0;
+    }
+
+    _elapsedUs += dtUs;
+    if (_elapsedUs < _periodUs) {
+        if (setpoint == 0) _output = 0;
+        return _output;
+    }
+
+    // counts / elapsed -> thousandths of a percent of top speed
+    const int32_t counts = encoderCount - _lastCount;
+    const int32_t measured = (int32_t)(((int64_t)counts * 100 * SCALE * 1000000)
+                                       / ((int64_t)_elapsedUs * _maxSpeed));
+    const int32_t prevMeasured = _measured;
+    const uint32_t elapsedUs = _elapsedUs;
+    _lastCount = encoderCount;
+    _elapsedUs = 0;
+    _measured = measured;
+
+    if (setpoint == 0) {
+        _integral = 0;
+        _output = 0;
+        return 0;
+    }
+
+    const int32_t limit = 100 * SCALE;
+    const int32_t target = (int32_t)setpoint * SCALE;
+    const int32_t error = target - measured;
+
+    const int32_t p = (int32_t)(((int64_t)_kp * error) / GAIN_ONE);
+
+    // Derivative on the measurement, so setpoint ramps do not kick it
+    const int32_t d = (int32_t)(((int64_t)_kd * (prevMeasured - measured) * 1000000)
+                                / ((int64_t)GAIN_ONE * elapsedUs));
+
+    const int32_t dI = (int32_t)(((int64_t)_ki * error * elapsedUs)
+                                 / ((int64_t)GAIN_ONE * 1000000));
+    const int32_t base = target + p + d;
+
+    // Anti-windup: only integrate when it does not push a saturated output further
+    const int32_t unclamped = base + _integral + dI;
+    const bool pushingHigh = unclamped > limit && dI > 0;
+    const bool pushingLow = unclamped < -limit && dI < 0;
+    if (!pushingHigh && !pushingLow) _integral = clamp32(_integral + dI, -limit, limit);
+
+    const int32_t out = clamp32(base + _integral, -limit, limit);
+    const int32_t half = SCALE / 2;
+    _output = (int8_t)((out >= 0 ? out + half : out - half) / SCALE);
+    return _output;
+}
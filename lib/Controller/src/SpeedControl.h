@@ -0,0 +1,73 @@
+//
+// Quadrature decoding and per-wheel speed PID for Controller's closed loop.
+//
+
+#ifndef THEFORGE2026_SPEED_CONTROL_H
+#define THEFORGE2026_SPEED_CONTROL_H
+
+#include <stdint.h>
+
+// Counts every edge of an A/B quadrature pair (4 counts per encoder line).
+// update() is called from the pin interrupts with the current pin levels;
+// invalid transitions (both pins changed, an edge was missed) count nothing.
+class QuadratureDecoder {
+public:
+    // ab: bit 1 = channel A, bit 0 = channel B
+    void begin(uint8_t ab) { _state = ab & 3; _count = 0; }
+    void update(uint8_t ab);
+
+    int32_t count() const { return _count; }
+
+private:
+    volatile int32_t _count = 0;
+    volatile uint8_t _state = 0;
+};
+
+// Tracks a speed setpoint (-100..100, percent of the wheel's top speed) from
+// encoder counts. Integer math throughout: speeds are in thousandths of a
+// percent and gains are Q10 (GAIN_ONE = 1.0).
+//
+// The setpoint is also fed forward as the base output, so the PID only
+// corrects the difference between wheels, load and battery level. The
+// integral stops growing while the output is saturated in the same
+// direction (anti-windup), and a zero setpoint resets it and outputs 0 so
+// braking and failsafe stay immediate.
+class WheelSpeedController {
+public:
+    static constexpr int32_t GAIN_ONE = 1024;
+    static constexpr int32_t SCALE = 1000;              // internal units per percent
+    static constexpr uint32_t DEFAULT_PERIOD_US = 10000;
+
+    void setGains(int32_t kp, int32_t ki, int32_t kd);
+
+    // Encoder counts per second at full output (measure it open loop)
+    void setMaxSpeed(uint32_t countsPerSec) { _maxSpeed = countsPerSec ? countsPerSec : 1; }
+
+    // Speed is measured over at least this long; shorter steps reuse the last output
+    void setPeriodUs(uint32_t periodUs) { _periodUs = periodUs; }
+
+    void reset();
+
+    // Call every control step with the encoder's running count; returns the
+    // drive output -100..100
+    int8_t step(int8_t setpoint, int32_t encoderCount, uint32_t dtUs);
+
+    // Last measured speed, percent of top speed
+    int16_t measuredPercent() const { return (int16_t)(_measured / SCALE); }
+
+private:
+    int32_t _kp = 2 * GAIN_ONE;
+    int32_t _ki = 10 * GAIN_ONE;
+    int32_t _kd = 0;
+    uint32_t _maxSpeed = 1000;
+    uint32_t _periodUs = DEFAULT_PERIOD_US;
+
+    bool _primed = false;       // _lastCount is valid
+    int32_t _lastCount = 0;
+    uint32_t _elapsedUs = 0;
+    int32_t _measured = 0;
+    int32_t _integral = 0;
+    int8_t _output = 0;
+};
+
+#endif // THEFORGE2026_SPEED_CONTROL_H
@@ -0,0 +1,17 @@
+//
+// Flash-resident page templates filled by generator callbacks.
+//
+
+#include "Template.h"
+
+#include <string.h>
+
+void renderTemplate(const TemplateFragment* fragments, uint8_t count,
+                    TemplateGenerator generator, void* ctx, ResponseWriter& out) {
+    for (uint8_t i = 0; i < count; i++) {
+        const TemplateFragment& f = fragments[i];
+        const size_t len = f.len ? f.len : strlen(f.text);
+        if (len) out.write((const uint8_t*)f.text, len);
+        if (f.slot != TEMPLATE_NO_SLOT) generator(ctx, f.slot, out);
+    }
+}
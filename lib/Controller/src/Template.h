@@ -0,0 +1,30 @@
+//
+// Flash-resident page templates filled by generator callbacks.
+//
+
+#ifndef THEFORGE2026_TEMPLATE_H
+#define THEFORGE2026_TEMPLATE_H
+
+#include <stdint.h>
+
+#include "ResponseWriter.h"
+
+static constexpr uint8_t TEMPLATE_NO_SLOT = 0xFF;
+
+// Static text followed by an optional placeholder. A template is an array of
+// these in flash; only the slot generators produce data at request time.
+struct TemplateFragment {
+    const char* text;
+    uint16_t len;    // 0 = NUL-terminated, measured when rendered
+    uint8_t slot;    // placeholder after the text, or TEMPLATE_NO_SLOT
+};
+
+// Writes the content for one placeholder
+typedef void (*TemplateGenerator)(void* ctx, uint8_t slot, ResponseWriter& out);
+
+// Streams fragments and generated content through out; RAM use is the
+// writer's buffer whatever the generators emit
+void renderTemplate(const TemplateFragment* fragments, uint8_t count,
+                    TemplateGenerator generator, void* ctx, ResponseWriter& out);
+
+#endif // THEFORGE2026_TEMPLATE_H
@@ -0,0 +1,62 @@
+//
+// Fixed-size binary drive packets for Controller's optional UDP listener.
+//
+
+#include "UdpDrive.h"
+
+uint16_t crc16Ccitt(const uint8_t* data, size_t len) {
+    uint16_t crc = 0xFFFF;
+    while (len--) {
+        crc ^= (uint16_t)(*data++) << 8;
+        for (uint8_t i = 0; i < 8; i++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+bool decodeUdpDrivePacket(const uint8_t* buf, size_t len, UdpDrivePacket& out) {
+    if (len != UDP_DRIVE_PACKET_SIZE) return false;
+    if (buf[0] != UDP_DRIVE_MAGIC) return false;
+
+    const uint16_t crc = (uint16_t)buf[10] | ((uint16_t)buf[11] << 8);
+    if (crc16Ccitt(buf, 10) != crc) return false;
+
+    out.x = (int8_t)buf[1];
+    out.y = (int8_t)buf[2];
+    out.t = buf[3];
+    out.seq = (uint16_t)buf[4] | ((uint16_t)buf[5] << 8);
+    out.clientMs = (uint32_t)buf[6] | ((uint32_t)buf[7] << 8)
+                 | ((uint32_t)buf[8] << 16) | ((uint32_t)buf[9] << 24);
+    return true;
+}
+
+void encodeUdpDrivePacket(const UdpDrivePacket& pkt, uint8_t* buf) {
+    buf[0] = UDP_DRIVE_MAGIC;
+    buf[1] = (uint8_t)pkt.x;
+    buf[2] = (uint8_t)pkt.y;
+    buf[3] = pkt.t;
+    buf[4] = (uint8_t)pkt.seq;
+    buf[5] = (uint8_t)(pkt.seq >> 8);
+    buf[6] = (uint8_t)pkt.clientMs;
+    buf[7] = (uint8_t)(pkt.clientMs >> 8);
+    buf[8] = (uint8_t)(pkt.clientMs >> 16);
+    buf[9] = (uint8_t)(pkt.clientMs >> 24);
+
+    const uint16_t crc = crc16Ccitt(buf, 10);
+    buf[10] = (uint8_t)crc;
+    buf[11] = (uint8_t)(crc >> 8);
+}
+
+bool UdpSequenceFilter::accept(uint16_t seq, unsigned long nowMs, unsigned long resyncMs) {
+    // Signed distance handles the 65535 -> 0 wrap
+    const bool newer = (int16_t)(seq - _lastSeq) > 0;
+    const bool stale = (nowMs - _lastMs) > resyncMs;
+
+    if (_synced && !newer && !stale) return false;
+
+    _lastSeq = seq;
+    _lastMs = nowMs;
+    _synced = true;
+    return true;
+}
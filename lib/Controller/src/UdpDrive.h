@@ -0,0 +1,52 @@
+//
+// Fixed-size binary drive packets for Controller's optional UDP listener.
+//
+
+#ifndef THEFORGE2026_UDP_DRIVE_H
+#define THEFORGE2026_UDP_DRIVE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Wire format (little-endian, 12 bytes):
+//   0  uint8   magic (UDP_DRIVE_MAGIC)
+//   1  int8    x        -100..100
+//   2  int8    y        -100..100
+//   3  uint8   t        0..100 (throttle)
+//   4  uint16  seq      incremented by the sender for every packet
+//   6  uint32  clientMs sender timestamp, reserved (not interpreted here)
+//  10  uint16  crc      CRC-16/CCITT-FALSE over bytes 0..9
+static constexpr uint8_t UDP_DRIVE_MAGIC = 0xD5;
+static constexpr uint8_t UDP_DRIVE_PACKET_SIZE = 12;
+
+struct UdpDrivePacket {
+    int8_t x = 0;
+    int8_t y = 0;
+    uint8_t t = 100;
+    uint16_t seq = 0;
+    uint32_t clientMs = 0;
+};
+
+uint16_t crc16Ccitt(const uint8_t* data, size_t len);
+
+// Returns false on wrong size, magic or CRC
+bool decodeUdpDrivePacket(const uint8_t* buf, size_t len, UdpDrivePacket& out);
+void encodeUdpDrivePacket(const UdpDrivePacket& pkt, uint8_t* buf);
+
+// Accepts only packets newer than the last accepted one (16-bit wrap-aware).
+// After resyncMs without an accepted packet any sequence is taken again, so a
+// restarted sender is not locked out. The window is passed per call so it
+// follows later changes to the caller's failsafe timeout.
+class UdpSequenceFilter {
+public:
+    void reset() { _synced = false; }
+
+    bool accept(uint16_t seq, unsigned long nowMs, unsigned long resyncMs);
+
+private:
+    uint16_t _lastSeq = 0;
+    unsigned long _lastMs = 0;
+    bool _synced = false;
+};
+
+#endif // THEFORGE2026_UDP_DRIVE_H
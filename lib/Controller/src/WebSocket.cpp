@@ -0,0 +1,181 @@
+//
+// Minimal RFC 6455 server-side helpers for Controller's /ws control channel.
+//
+
+#include "WebSocket.h"
+
+#include <string.h>
+
+// -------------------- Handshake (SHA-1 + base64) --------------------
+
+static const char kWebSocketGuid[] = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+
+static uint32_t rol(uint32_t v, uint8_t bits) {
+    return (v << bits) | (v >> (32 - bits));
+}
+
+static void sha1Block(uint32_t h[5], const uint8_t block[64]) {
+    uint32_t w[80];
+    for (uint8_t i = 0; i < 16; i++) {
+        w[i] = ((uint32_t)block[i * 4] << 24) | ((uint32_t)block[i * 4 + 1] << 16)
+             | ((uint32_t)block[i * 4 + 2] << 8) | (uint32_t)block[i * 4 + 3];
+    }
+    for (uint8_t i = 16; i < 80; i++) {
+        w[i] = rol(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+    }
+
+    uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+    for (uint8_t i = 0; i < 80; i++) {
+        uint32_t f, k;
+        if (i < 20)      { f = (b & c) | (~b & d);          k = 0x5A827999; }
+        else if (i < 40) { f = b ^ c ^ d;                   k = 0x6ED9EBA1; }
+        else if (i < 60) { f = (b & c) | (b & d) | (c & d); k = 0x8F1BBCDC; }
+        else             { f = b ^ c ^ d;                   k = 0xCA62C1D6; }
+
+        uint32_t tmp = rol(a, 5) + f + e + k + w[i];
+        e = d;
+        d = c;
+        c = rol(b, 30);
+        b = a;
+        a = tmp;
+    }
+
+    h[0] += a; h[1] += b; h[2] += c; h[3] += d; h[4] += e;
+}
+
+// SHA-1 of a message shorter than 120 bytes (always fits in two blocks)
+static void sha1Short(const uint8_t* msg, uint8_t len, uint8_t digest[20]) {
+    uint32_t h[5] = { 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0 };
+
+    uint8_t buf[128];
+    memset(buf, 0, sizeof(buf));
+    memcpy(buf, msg, len);
+    buf[len] = 0x80;
+
+    const uint8_t blocks = (len + 9 <= 64) ? 1 : 2;
+    const uint32_t bitLen = (uint32_t)len * 8;
+    uint8_t* tail = buf + blocks * 64 - 4;
+    tail[0] = (uint8_t)(bitLen >> 24);
+    tail[1] = (uint8_t)(bitLen >> 16);
+    tail[2] = (uint8_t)(bitLen >> 8);
+    tail[3] = (uint8_t)bitLen;
+
+    for (uint8_t i = 0; i < blocks; i++) sha1Block(h, buf + i * 64);
+
+    for (uint8_t i = 0; i < 5; i++) {
+        digest[i * 4]     = (uint8_t)(h[i] >> 24);
+        digest[i * 4 + 1] = (uint8_t)(h[i] >> 16);
+        digest[i * 4 + 2] = (uint8_t)(h[i] >> 8);
+        digest[i * 4 + 3] = (uint8_t)h[i];
+    }
+}
+
+static void base64Encode(const uint8_t* in, uint8_t len, char* out) {
+    static const char table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    uint8_t o = 0;
+    for (uint8_t i = 0; i < len; i += 3) {
+        uint32_t v = (uint32_t)in[i] << 16;
+        if (i + 1 < len) v |= (uint32_t)in[i + 1] << 8;
+        if (i + 2 < len) v |= in[i + 2];
+
+        out[o++] = table[(v >> 18) & 0x3F];
+        out[o++] = table[(v >> 12) & 0x3F];
+        out[o++] = (i + 1 < len) ? table[(v >> 6) & 0x3F] : '=';
+        out[o++] = (i + 2 < len) ? table[v & 0x3F] : '=';
+    }
+    out[o] = '\0';
+}
+
+void webSocketAcceptKey(const char* clientKey, char* out) {
+    uint8_t msg[WS_KEY_LEN + sizeof(kWebSocketGuid)];
+    uint8_t keyLen = (uint8_t)strnlen(clientKey, WS_KEY_LEN);
+    memcpy(msg, clientKey, keyLen);
+    memcpy(msg + keyLen, kWebSocketGuid, sizeof(kWebSocketGuid) - 1);
+
+    uint8_t digest[20];
+    sha1Short(msg, (uint8_t)(keyLen + sizeof(kWebSocketGuid) - 1), digest);
+    base64Encode(digest, sizeof(digest), out);
+}
+
+uint8_t webSocketFrameHeader(uint8_t opcode, uint16_t payloadLen, uint8_t* out) {
+    out[0] = (uint8_t)(0x80 | (opcode & 0x0F));   // FIN + opcode
+    if (payloadLen < 126) {
+        out[1] = (uint8_t)payloadLen;
+        return 2;
+    }
+    out[1] = 126;
+    out[2] = (uint8_t)(payloadLen >> 8);
+    out[3] = (uint8_t)payloadLen;
+    return 4;
+}
+
+// -------------------- Frame parser --------------------
+
+WebSocketFrameParser::WebSocketFrameParser() {
+    reset();
+}
+
+void WebSocketFrameParser::reset() {
+    _state = HEADER0;
+    _opcode = 0;
+    _extLenBytes = 0;
+    _pos = 0;
+    _len = 0;
+}
+
+WebSocketFrameParser::Result WebSocketFrameParser::feed(uint8_t b) {
+    switch (_state) {
+
+        case HEADER0:
+            // Our messages are tiny: no fragmentation, no extensions
+            if (!(b & 0x80) || (b & 0x70)) return ERROR;
+            _opcode = b & 0x0F;
+            if (_opcode == WS_OP_CONTINUATION) return ERROR;
+            _state = HEADER1;
+            return NEED_MORE;
+
+        case HEADER1:
+            // Client frames must be masked (RFC 6455 5.1)
+            if (!(b & 0x80)) return ERROR;
+            _len = b & 0x7F;
+            if (_len == 127) return ERROR;
+            if (_len == 126) {
+                _len = 0;
+                _extLenBytes = 2;
+                _pos = 0;
+                _state = EXT_LEN;
+                return NEED_MORE;
+            }
+            return finishHeader();
+
+        case EXT_LEN:
+            _len = (uint16_t)((_len << 8) | b);
+            if (++_pos < _extLenBytes) return NEED_MORE;
+            return finishHeader();
+
+        case MASK_KEY:
+            _mask[_pos++] = b;
+            if (_pos < 4) return NEED_MORE;
+            _pos = 0;
+            if (_len == 0) {
+                _state = HEADER0;
+                return FRAME;
+            }
+            _state = PAYLOAD;
+            return NEED_MORE;
+
+        case PAYLOAD:
+            _payload[_pos] = b ^ _mask[_pos & 3];
+            if (++_pos < _len) return NEED_MORE;
+            _state = HEADER0;
+            return FRAME;
+    }
+    return ERROR;
+}
+
+WebSocketFrameParser::Result WebSocketFrameParser::finishHeader() {
+    if (_len > MAX_PAYLOAD) return ERROR;
+    _pos = 0;
+    _state = MASK_KEY;
+    return NEED_MORE;
+}
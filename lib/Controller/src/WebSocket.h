@@ -0,0 +1,70 @@
+//
+// Minimal RFC 6455 server-side helpers for Controller's /ws control channel.
+//
+
+#ifndef THEFORGE2026_WEBSOCKET_H
+#define THEFORGE2026_WEBSOCKET_H
+
+#include <stdint.h>
+
+static constexpr uint8_t WS_OP_CONTINUATION = 0x0;
+static constexpr uint8_t WS_OP_TEXT         = 0x1;
+static constexpr uint8_t WS_OP_BINARY       = 0x2;
+static constexpr uint8_t WS_OP_CLOSE        = 0x8;
+static constexpr uint8_t WS_OP_PING         = 0x9;
+static constexpr uint8_t WS_OP_PONG         = 0xA;
+
+static constexpr uint8_t WS_KEY_LEN        = 24;   // base64 of a 16-byte nonce
+static constexpr uint8_t WS_ACCEPT_KEY_LEN = 28;   // base64 of a SHA-1 digest
+
+// Sec-WebSocket-Accept for a client's Sec-WebSocket-Key.
+// out must hold WS_ACCEPT_KEY_LEN + 1 bytes (NUL-terminated).
+void webSocketAcceptKey(const char* clientKey, char* out);
+
+// Writes an unmasked, final frame header into out (at most 4 bytes) and
+// returns its length. Payloads are limited to 64 KB.
+uint8_t webSocketFrameHeader(uint8_t opcode, uint16_t payloadLen, uint8_t* out);
+
+// Incremental decoder for client-to-server frames. Control messages on this
+// channel are a few bytes, so payloads live in a small fixed buffer and
+// anything larger (or fragmented) is rejected.
+class WebSocketFrameParser {
+public:
+    static constexpr uint8_t MAX_PAYLOAD = 32;
+
+    enum Result : uint8_t {
+        NEED_MORE,
+        FRAME,     // opcode()/payload() describe a complete frame
+        ERROR      // protocol violation: close the connection
+    };
+
+    WebSocketFrameParser();
+
+    void reset();
+    Result feed(uint8_t b);
+
+    uint8_t opcode() const { return _opcode; }
+    const uint8_t* payload() const { return _payload; }
+    uint8_t payloadLength() const { return (uint8_t)_len; }
+
+private:
+    enum State : uint8_t {
+        HEADER0,
+        HEADER1,
+        EXT_LEN,
+        MASK_KEY,
+        PAYLOAD
+    };
+
+    Result finishHeader();
+
+    State _state;
+    uint8_t _opcode;
+    uint8_t _extLenBytes;   // 2 for 16-bit lengths; 64-bit lengths are rejected
+    uint8_t _pos;
+    uint16_t _len;
+    uint8_t _mask[4];
+    uint8_t _payload[MAX_PAYLOAD];
+};
+
+#endif // THEFORGE2026_WEBSOCKET_H
@@ -0,0 +1,237 @@
+//
+// Button and slider registry for the web page, with deferred callbacks.
+//
+
+#include "WidgetRegistry.h"
+
+#include <string.h>
+
+static int clampValue(int v, int lo, int hi) {
+    if (v < lo) return lo;
+    if (v > hi) return hi;
+    return v;
+}
+
+static uint32_t fnv1a(uint32_t h, const void* data, size_t len) {
+    const uint8_t* p = (const uint8_t*)data;
+    for (size_t i = 0; i < len; i++) {
+        h ^= p[i];
+        h *= 16777619UL;
+    }
+    return h;
+}
+
+WidgetRegistry::WidgetRegistry(ButtonWidget* buttons, uint8_t maxButtons,
+                               SliderWidget* sliders, uint8_t maxSliders)
+    : _buttons(buttons), _sliders(sliders), _maxButtons(maxButtons), _maxSliders(maxSliders) {}
+
+// -------------------- Registration --------------------
+
+bool WidgetRegistry::addButton(const char* label, void (*cb)()) {
+    if (_buttonCount >= _maxButtons) return false;
+    ButtonWidget& b = _buttons[_buttonCount];
+    b.label = label ? label : "";
+    b.cb = cb;
+    _buttonCount++;
+    _version++;
+    return true;
+}
+
+void WidgetRegistry::clearButtons() {
+    _buttonCount = 0;
+    _buttonGeneration++;
+    _version++;
+}
+
+bool WidgetRegistry::addSlider(const char* label, void (*cb)(int value),
+                               int minVal, int maxVal, int initial, int step) {
+    if (_sliderCount >= _maxSliders) return false;
+    if (minVal > maxVal) { int tmp = minVal; minVal = maxVal; maxVal = tmp; }
+    if (step <= 0) step = 1;
+
+    SliderWidget& s = _sliders[_sliderCount];
+    s.label   = label ? label : "";
+    s.minVal  = minVal;
+    s.maxVal  = maxVal;
+    s.step    = step;
+    s.value   = clampValue(initial, minVal, maxVal);
+    s.cb      = cb;
+    s.pending = false;
+
+    _sliderCount++;
+    _version++;
+    return true;
+}
+
+void WidgetRegistry::clearSliders() {
+    for (uint8_t i = 0; i < _sliderCount; i++) _sliders[i].pending = false;
+    _sliderCount = 0;
+    _sliderGeneration++;
+    _version++;
+}
+
+// -------------------- Events --------------------
+
+uint8_t WidgetRegistry::sharedSlots() const {
+    const uint8_t reserved = _sliderCount < EVENT_QUEUE_SIZE / 2 ? _sliderCount : EVENT_QUEUE_SIZE / 2;
+    return EVENT_QUEUE_SIZE - reserved;
+}
+
+WidgetStatus WidgetRegistry::queue(WidgetEventType type, uint8_t id, const char* text) {
+    QueuedEvent e;
+    e.type = type;
+    e.id = id;
+    e.generation = type == WIDGET_SLIDER ? _sliderGeneration : _buttonGeneration;
+    e.textLen = 0;
+
+    if (text) {
+        while (e.textLen < EVENT_TEXT_MAX && text[e.textLen]) e.textLen++;
+        const uint8_t used = (uint8_t)(_textHead - _textTail);
+        if (EVENT_TEXT_POOL - used < e.textLen) return WIDGET_BUSY;
+        for (uint8_t i = 0; i < e.textLen; i++) {
+            _text[(uint8_t)(_textHead + i) & (EVENT_TEXT_POOL - 1)] = text[i];
+        }
+    }
+
+    if (!_events.push(e)) return WIDGET_BUSY;
+    _textHead = (uint8_t)(_textHead + e.textLen);
+    return WIDGET_OK;
+}
+
+WidgetStatus WidgetRegistry::press(int id) {
+    if (id < 0 || id >= (int)_buttonCount) return WIDGET_BAD_ID;
+    if (_events.size() >= sharedSlots()) return WIDGET_BUSY;
+    return queue(WIDGET_BUTTON, (uint8_t)id, nullptr);
+}
+
+WidgetStatus WidgetRegistry::setSlider(int id, int value) {
+    if (id < 0 || id >= (int)_sliderCount) return WIDGET_BAD_ID;
+
+    SliderWidget& s = _sliders[id];
+    s.value = clampValue(value, s.minVal, s.maxVal);
+    _version++;   // the rendered page inlines slider values
+
+    // Already queued: the callbacks will see this value
+    if (s.pending) return WIDGET_OK;
+
+    const WidgetStatus status = queue(WIDGET_SLIDER, (uint8_t)id, nullptr);
+    if (status == WIDGET_OK) s.pending = true;
+    return status;
+}
+
+WidgetStatus WidgetRegistry::message(const char* text) {
+    if (_events.size() >= sharedSlots()) return WIDGET_BUSY;
+    return queue(WIDGET_MESSAGE, 0, text);
+}
+
+void WidgetRegistry::dispatch(WidgetEventCallback cb, void* ctx) {
+    QueuedEvent e;
+    char text[EVENT_TEXT_MAX + 1];
+    while (_events.pop(e)) {
+        WidgetEvent ev = { e.type, e.id, "", 0, "" };
+
+        switch (e.type) {
+            case WIDGET_BUTTON: {
+                if (e.generation != _buttonGeneration || e.id >= _buttonCount) continue;   // cleared since
+                const ButtonWidget& b = _buttons[e.id];
+                if (b.cb) b.cb();
+                ev.label = b.label;
+                break;
+            }
+
+            case WIDGET_SLIDER: {
+                if (e.generation != _sliderGeneration || e.id >= _sliderCount) continue;   // cleared since
+                SliderWidget& s = _sliders[e.id];
+                s.pending = false;
+                if (s.cb) s.cb(s.value);
+                ev.label = s.label;
+                ev.value = s.value;
+                break;
+            }
+
+            case WIDGET_MESSAGE:
+                for (uint8_t i = 0; i < e.textLen; i++) {
+                    text[i] = _text[(uint8_t)(_textTail + i) & (EVENT_TEXT_POOL - 1)];
+                }
+                text[e.textLen] = '\0';
+                _textTail = (uint8_t)(_textTail + e.textLen);
+                ev.text = text;
+                break;
+        }
+
+        if (cb) cb(ev, ctx);
+    }
+}
+
+// -------------------- Page data --------------------
+
+uint32_t WidgetRegistry::hash() {
+    // Only rehash after a change; a 304 renders nothing
+    if (_hashVersion == _version) return _hash;
+
+    uint32_t h = 2166136261UL;
+    for (uint8_t i = 0; i < _buttonCount; i++) {
+        h = fnv1a(h, _buttons[i].label, strlen(_buttons[i].label) + 1);
+    }
+    h = fnv1a(h, &_sliderCount, 1);
+    for (uint8_t i = 0; i < _sliderCount; i++) {
+        const SliderWidget& s = _sliders[i];
+        const int nums[4] = { s.minVal, s.maxVal, s.step, s.value };
+        h = fnv1a(h, s.label, strlen(s.label) + 1);
+        h = fnv1a(h, nums, sizeof(nums));
+    }
+
+    _hash = h;
+    _hashVersion = _version;
+    return h;
+}
+
+void WidgetRegistry::writeButtonsJson(ResponseWriter& out) const {
+    for (uint8_t i = 0; i < _buttonCount; i++) {
+        if (i) out.print(',');
+        out.print("{\"id\":");
+        out.print((int)i);
+        out.print(",\"label\":");
+        writeJsonString(out, _buttons[i].label);
+        out.print('}');
+    }
+}
+
+void WidgetRegistry::writeSlidersJson(ResponseWriter& out) const {
+    for (uint8_t i = 0; i < _sliderCount; i++) {
+        const SliderWidget& s = _sliders[i];
+        if (i) out.print(',');
+        out.print("{\"id\":");
+        out.print((int)i);
+        out.print(",\"label\":");
+        writeJsonString(out, s.label);
+        out.print(",\"min\":");
+        out.print(s.minVal);
+        out.print(",\"max\":");
+        out.print(s.maxVal);
+        out.print(",\"step\":");
+        out.print(s.step);
+        out.print(",\"value\":");
+        out.print(s.value);
+        out.print('}');
+    }
+}
+
+void WidgetRegistry::writeJsonString(ResponseWriter& out, const char* s) {
+    static const char hex[] = "0123456789abcdef";
+    out.print('"');
+    for (; *s; s++) {
+        const char c = *s;
+        if (c == '"' || c == '\\') {
+            out.print('\\');
+            out.print(c);
+        } else if ((uint8_t)c < 0x20 || c == '<') {
+            out.print("\\u00");
+            out.print(hex[(c >> 4) & 0xF]);
+            out.print(hex[c & 0xF]);
+        } else {
+            out.print(c);
+        }
+    }
+    out.print('"');
+}
@@ -0,0 +1,164 @@
+//
+// Button and slider registry for the web page, with deferred callbacks.
+//
+
+#ifndef THEFORGE2026_WIDGET_REGISTRY_H
+#define THEFORGE2026_WIDGET_REGISTRY_H
+
+#include <stdint.h>
+
+#include "EventQueue.h"
+#include "ResponseWriter.h"
+
+// Labels are not copied: pass string literals or other storage that lives
+// as long as the registration.
+struct ButtonWidget {
+    const char* label = "";
+    void (*cb)() = nullptr;
+};
+
+struct SliderWidget {
+    const char* label = "";
+    int minVal = 0;
+    int maxVal = 100;
+    int step   = 1;
+    int value  = 0;              // stored current value
+    void (*cb)(int value) = nullptr;
+    bool pending = false;        // an event is queued for this slider
+};
+
+enum WidgetEventType : uint8_t {
+    WIDGET_BUTTON,
+    WIDGET_SLIDER,
+    WIDGET_MESSAGE     // /control?msg=...
+};
+
+// Handed to the event callback; pointers are valid during the call only
+struct WidgetEvent {
+    WidgetEventType type;
+    uint8_t id;          // button or slider index
+    const char* label;   // widget label, "" for messages
+    int value;           // slider value, 0 otherwise
+    const char* text;    // message text, "" otherwise
+};
+
+typedef void (*WidgetEventCallback)(const WidgetEvent& event, void* ctx);
+
+enum WidgetStatus : uint8_t {
+    WIDGET_OK,
+    WIDGET_BAD_ID,
+    WIDGET_BUSY        // event queue full
+};
+
+// Everything the page's buttons and sliders need, in storage sized at
+// compile time (see Widgets<> below) so nothing is allocated after setup.
+//
+// press(), setSlider() and message() only queue an event and return, so
+// a request handler can answer at once; dispatch() later runs the widget
+// callbacks and the event callback. A slider is queued at most once until
+// dispatched and the callbacks get the value current at that point, so a
+// burst of drags is one call. Up to EVENT_QUEUE_SIZE / 2 slots are kept
+// for sliders, so with that many sliders or fewer a slider change is
+// never dropped. Message text lives in one shared EVENT_TEXT_POOL ring
+// rather than in every queue entry, so an entry is 4 bytes.
+class WidgetRegistry {
+public:
+    static constexpr uint8_t EVENT_QUEUE_SIZE = 16;
+    static constexpr uint8_t EVENT_TEXT_MAX = 48;    // longer messages are cut
+    static constexpr uint8_t EVENT_TEXT_POOL = 128;  // text of all queued messages
+
+    WidgetRegistry(ButtonWidget* buttons, uint8_t maxButtons,
+                   SliderWidget* sliders, uint8_t maxSliders);
+
+    WidgetRegistry(const WidgetRegistry&) = delete;
+    WidgetRegistry& operator=(const WidgetRegistry&) = delete;
+
+    bool addButton(const char* label, void (*cb)());
+    void clearButtons();
+    uint8_t buttonCount() const { return _buttonCount; }
+    uint8_t maxButtons() const { return _maxButtons; }
+    const ButtonWidget& button(uint8_t i) const { return _buttons[i]; }
+
+    // min/max are swapped if reversed, step is at least 1, initial is clamped
+    bool addSlider(const char* label, void (*cb)(int value),
+                   int minVal, int maxVal, int initial, int step);
+    void clearSliders();
+    uint8_t sliderCount() const { return _sliderCount; }
+    uint8_t maxSliders() const { return _maxSliders; }
+    const SliderWidget& slider(uint8_t i) const { return _sliders[i]; }
+
+    WidgetStatus press(int id);
+    WidgetStatus setSlider(int id, int value);   // value is clamped and stored at once
+    WidgetStatus message(const char* text);
+
+    // Run the callbacks for everything queued so far; cb may be nullptr
+    void dispatch(WidgetEventCallback cb, void* ctx);
+
+    // Bumped by every change that shows on the page (including slider values)
+    uint32_t version() const { return _version; }
+
+    // FNV-1a over labels and slider settings, cached per version, so an
+    // ETag survives a reboot that registers the same widgets
+    uint32_t hash();
+
+    // /ui.json arrays, without brackets:
+    //   {"id":0,"label":"..."},...
+    //   {"id":0,"label":"...","min":0,"max":100,"step":1,"value":0},...
+    void writeButtonsJson(ResponseWriter& out) const;
+    void writeSlidersJson(ResponseWriter& out) const;
+
+    // JSON string literal; '<' is escaped too so a label cannot close the
+    // page's inline <script>
+    static void writeJsonString(ResponseWriter& out, const char* s);
+
+private:
+    struct QueuedEvent {
+        WidgetEventType type;
+        uint8_t id;
+        uint8_t generation;   // of buttons or sliders when queued
+        uint8_t textLen;      // WIDGET_MESSAGE: bytes at _textTail in _text
+    };
+    static_assert((EVENT_TEXT_POOL & (EVENT_TEXT_POOL - 1)) == 0 && EVENT_TEXT_POOL <= 128,
+                  "EVENT_TEXT_POOL must be a power of two <= 128");
+
+    // Slots left for buttons and messages
+    uint8_t sharedSlots() const;
+    WidgetStatus queue(WidgetEventType type, uint8_t id, const char* text);
+
+    ButtonWidget* _buttons;
+    SliderWidget* _sliders;
+    uint8_t _maxButtons;
+    uint8_t _maxSliders;
+    uint8_t _buttonCount = 0;
+    uint8_t _sliderCount = 0;
+
+    // Bumped by clearButtons()/clearSliders() so events queued for the old
+    // widgets are dropped instead of reaching whatever reuses their id
+    uint8_t _buttonGeneration = 0;
+    uint8_t _sliderGeneration = 0;
+
+    uint32_t _version = 1;
+    uint32_t _hashVersion = 0;
+    uint32_t _hash = 0;
+
+    SpscQueue<QueuedEvent, EVENT_QUEUE_SIZE> _events;
+
+    // Messages leave the queue in order, so their text is a ring too: the
+    // producer moves _textHead, dispatch() moves _textTail (both wrap at 256)
+    char _text[EVENT_TEXT_POOL];
+    uint8_t _textHead = 0;
+    uint8_t _textTail = 0;
+};
+
+// Registry with room for MaxButtons buttons and MaxSliders sliders
+template <uint8_t MaxButtons, uint8_t MaxSliders>
+class Widgets : public WidgetRegistry {
+public:
+    Widgets() : WidgetRegistry(_buttonStore, MaxButtons, _sliderStore, MaxSliders) {}
+
+private:
+    ButtonWidget _buttonStore[MaxButtons];
+    SliderWidget _sliderStore[MaxSliders];
+};
+
+#endif // THEFORGE2026_WIDGET_REGISTRY_H
@@ -0,0 +1,155 @@
+#!/usr/bin/env python3
+"""Embed the Controller web UI into the firmware.
+
+Reads lib/Controller/ui/index.html, strips indentation and comment-only
+lines and writes lib/Controller/src/ControllerUi.h (flash on the Uno R4) with:
+
+  * a gzipped static shell: lines holding {{slot}} placeholders are left out,
+    and the page fetches /ui.json instead;
+  * the full page as a template: text fragments split at the placeholders,
+    which Controller fills with generator callbacks while streaming.
+
+Runs automatically before every PlatformIO build (extra_scripts in
+platformio.ini) and can be run by hand:
+
+    python3 scripts/embed_ui.py
+
+The generated header is committed so the library also builds from the
+Arduino IDE, where this script does not run.
+"""
+
+import gzip
+import hashlib
+import os
+import re
+
+try:
+    Import("env")  # noqa: F821 -- provided by PlatformIO/SCons
+    PROJECT_DIR = env.subst("$PROJECT_DIR")  # noqa: F821
+except NameError:
+    PROJECT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+SOURCE = os.path.join(PROJECT_DIR, "lib", "Controller", "ui", "index.html")
+OUTPUT = os.path.join(PROJECT_DIR, "lib", "Controller", "src", "ControllerUi.h")
+
+# Placeholder names, in ControllerUiSlot order (see Controller::writeUiSlot)
+SLOTS = ("throttle", "failsafe", "mode", "buttons", "sliders")
+PLACEHOLDER = re.compile(r"\{\{(\w+)\}\}")
+
+
+def minify(html):
+    html = re.sub(r"/\*.*?\*/", "", html, flags=re.S)  # CSS comments
+    lines = []
+    for line in html.splitlines():
+        line = line.strip()
+        if not line or line.startswith("//"):
+            continue
+        lines.append(line)
+    return "\n".join(lines) + "\n"
+
+
+def c_bytes(data, indent="    ", per_line=16):
+    rows = []
+    for i in range(0, len(data), per_line):
+        rows.append(indent + ", ".join("0x%02x" % b for b in data[i:i + per_line]) + ",")
+    return "\n".join(rows)
+
+
+def c_string(text, indent="    "):
+    rows = []
+    for line in text.splitlines(True):
+        escaped = line.replace("\\", "\\\\").replace('"', '\\"').replace("\n", "\\n")
+        rows.append(indent + '"' + escaped + '"')
+    return "\n".join(rows)
+
+
+def static_shell(page):
+    return "".join(line for line in page.splitlines(True) if not PLACEHOLDER.search(line))
+
+
+def split_template(page):
+    """[(text, slot name or None)]: each fragment's text is followed by its slot."""
+    fragments = []
+    pos = 0
+    for m in PLACEHOLDER.finditer(page):
+        if m.group(1) not in SLOTS:
+            raise SystemExit("embed_ui: unknown placeholder {{%s}}" % m.group(1))
+        fragments.append((page[pos:m.start()], m.group(1)))
+        pos = m.end()
+    fragments.append((page[pos:], None))
+    return fragments
+
+
+def c_template(fragments):
+    texts = []
+    entries = []
+    for i, (text, slot) in enumerate(fragments):
+        name = "CONTROLLER_UI_TEXT_%d" % i
+        texts.append("static const char %s[] =\n%s;" % (name, c_string(text) or '    ""'))
+        slot_id = "CONTROLLER_UI_SLOT_" + slot.upper() if slot else "TEMPLATE_NO_SLOT"
+        entries.append("    { %s, sizeof(%s) - 1, %s }," % (name, name, slot_id))
+    return "\n".join(texts), "\n".join(entries)
+
+
+def render(html):
+    page = minify(html)
+    shell = static_shell(page).encode("utf-8")
+    packed = gzip.compress(shell, compresslevel=9, mtime=0)
+    fragments = split_template(page)
+    texts, entries = c_template(fragments)
+    # Changes whenever the page does; Controller adds the widget state for ETags
+    digest = hashlib.sha1(packed + page.encode("utf-8")).hexdigest()[:8]
+
+    return """\
+// Generated by scripts/embed_ui.py from lib/Controller/ui/index.html -- do not edit.
+// Shell: {plain} bytes plain, {packed} bytes gzipped. Template: {count} fragments.
+
+#ifndef THEFORGE2026_CONTROLLER_UI_H
+#define THEFORGE2026_CONTROLLER_UI_H
+
+#include <stdint.h>
+
+#include "Template.h"
+
+enum ControllerUiSlot : uint8_t {{
+{slots}
+}};
+
+// Static shell for clients that send Accept-Encoding: gzip
+static const uint8_t CONTROLLER_UI_GZ[] = {{
+{gz}
+}};
+static const uint32_t CONTROLLER_UI_GZ_LEN = {packed};
+
+// Full page with the widgets inlined, rendered for everyone else
+{texts}
+
+static const TemplateFragment CONTROLLER_UI_TEMPLATE[] = {{
+{entries}
+}};
+static const uint8_t CONTROLLER_UI_TEMPLATE_COUNT = {count};
+
+static const char CONTROLLER_UI_HASH[] = "{digest}";
+
+#endif // THEFORGE2026_CONTROLLER_UI_H
+""".format(plain=len(shell), packed=len(packed), gz=c_bytes(packed),
+           slots="\n".join("    CONTROLLER_UI_SLOT_%s," % n.upper() for n in SLOTS),
+           texts=texts, entries=entries, count=len(fragments), digest=digest)
+
+
+def main():
+    with open(SOURCE, encoding="utf-8") as f:
+        header = render(f.read())
+
+    # Only touch the file when it changes, so unchanged UIs do not trigger a rebuild
+    if os.path.exists(OUTPUT):
+        with open(OUTPUT, encoding="utf-8") as f:
+            if f.read() == header:
+                return
+
+    with open(OUTPUT, "w", encoding="utf-8", newline="\n") as f:
+        f.write(header)
+    print("embed_ui: regenerated " + os.path.relpath(OUTPUT, PROJECT_DIR))
+
+
+main()
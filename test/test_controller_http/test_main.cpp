@@ -10,10 +10,12 @@ static Controller ctrl("TeamRobot", "12345678");
 // For verifying /control callback
 static volatile bool g_cb_called = false;
 static String g_last_msg;
+static int g_ctx_tag = 42;
 
-static void onMessage(const String& msg) {
+static void onEvent(const WidgetEvent& e, void* ctx) {
+  if (e.type != WIDGET_MESSAGE || ctx != &g_ctx_tag) return;
   g_cb_called = true;
-  g_last_msg = msg;
+  g_last_msg = e.text;
 }
 
 // Unity required hooks
@@ -24,7 +26,7 @@ void setUp(void) {
 
 void tearDown(void) {}
 
-static String httpGetAndPump(const char* path, uint32_t pumpMs = 300) {
+static String httpGetAndPump(const char* path, uint32_t pumpMs = 300, const char* extraHeaders = nullptr) {
   IPAddress ip = WiFi.localIP();
   TEST_ASSERT_TRUE_MESSAGE(ip[0] != 0, "WiFi.localIP() invalid (AP not started?)");
 
@@ -37,6 +39,7 @@ static String httpGetAndPump(const char* path, uint32_t pumpMs = 300) {
   c.print("Host: ");
   c.println(ip);
   c.println("Connection: close");
+  if (extraHeaders) c.print(extraHeaders);   // full lines, CRLF-terminated
   c.println();
 
   // Important: your server only responds when update() runs
@@ -80,7 +83,7 @@ void test_control_triggers_callback(void) {
     TEST_ASSERT_TRUE(ctrl.beginAP());
   }
 
-  ctrl.registerCallback(onMessage);
+  ctrl.registerEventCallback(onEvent, &g_ctx_tag);
 
   String resp = httpGetAndPump("/control?msg=hello+world");
   TEST_ASSERT_TRUE_MESSAGE(resp.indexOf("200 OK") >= 0, "No 200 OK for /control");
@@ -90,6 +93,105 @@ void test_control_triggers_callback(void) {
   TEST_ASSERT_EQUAL_STRING_MESSAGE("hello world", g_last_msg.c_str(), "Message mismatch");
 }
 
+static void onTestButton() {}
+
+void test_ui_manifest_lists_buttons(void) {
+  if (WiFi.status() != WL_AP_LISTENING) {
+    TEST_ASSERT_TRUE(ctrl.beginAP());
+  }
+
+  ctrl.clearButtons();
+  ctrl.registerButton("Say \"hi\"", onTestButton);
+
+  String resp = httpGetAndPump("/ui.json");
+  TEST_ASSERT_TRUE_MESSAGE(resp.indexOf("200 OK") >= 0, "No 200 OK for /ui.json");
+  TEST_ASSERT_TRUE_MESSAGE(resp.indexOf("application/json") >= 0, "Wrong content type");
+  TEST_ASSERT_TRUE_MESSAGE(resp.indexOf("\"label\":\"Say \\\"hi\\\"\"") >= 0, "Label missing or not escaped");
+  TEST_ASSERT_TRUE_MESSAGE(resp.indexOf("\"mode\":\"arcade\"") >= 0, "Drive mode missing");
+
+  ctrl.clearButtons();
+}
+
+void test_root_inlines_widgets(void) {
+  if (WiFi.status() != WL_AP_LISTENING) {
+    TEST_ASSERT_TRUE(ctrl.beginAP());
+  }
+
+  ctrl.clearButtons();
+  ctrl.registerButton("Inline me", onTestButton);
+
+  // No Accept-Encoding: the page is rendered from the template, chunked
+  String resp = httpGetAndPump("/");
+  TEST_ASSERT_TRUE_MESSAGE(resp.indexOf("200 OK") >= 0, "No 200 OK");
+  TEST_ASSERT_TRUE_MESSAGE(resp.indexOf("Transfer-Encoding: chunked") >= 0, "Page not chunked");
+  TEST_ASSERT_TRUE_MESSAGE(resp.indexOf("\"label\":\"Inline me\"") >= 0, "Button not inlined");
+  TEST_ASSERT_TRUE_MESSAGE(resp.endsWith("0\r\n\r\n"), "Missing last chunk");
+
+  ctrl.clearButtons();
+}
+
+void test_root_conditional_get(void) {
+  if (WiFi.status() != WL_AP_LISTENING) {
+    TEST_ASSERT_TRUE(ctrl.beginAP());
+  }
+
+  String resp = httpGetAndPump("/", 300, "Accept-Encoding: gzip\r\n");
+  const int at = resp.indexOf("ETag: ");
+  TEST_ASSERT_TRUE_MESSAGE(at >= 0, "No ETag on /");
+  const String etag = resp.substring(at + 6, resp.indexOf("\r\n", at));
+
+  // Same page: 304 with no body
+  String hdr = String("Accept-Encoding: gzip\r\nIf-None-Match: ") + etag + "\r\n";
+  resp = httpGetAndPump("/", 300, hdr.c_str());
+  TEST_ASSERT_TRUE_MESSAGE(resp.indexOf("304 Not Modified") >= 0, "No 304 for a matching ETag");
+  TEST_ASSERT_TRUE_MESSAGE(resp.endsWith("\r\n\r\n"), "304 must not carry a body");
+
+  // The rendered page's ETag follows the registry
+  resp = httpGetAndPump("/");
+  const int at2 = resp.indexOf("ETag: ");
+  TEST_ASSERT_TRUE(at2 >= 0);
+  const String before = resp.substring(at2 + 6, resp.indexOf("\r\n", at2));
+  ctrl.registerButton("New", onTestButton);
+  hdr = String("If-None-Match: ") + before + "\r\n";
+  resp = httpGetAndPump("/", 300, hdr.c_str());
+  TEST_ASSERT_TRUE_MESSAGE(resp.indexOf("200 OK") >= 0, "Registry change must invalidate the ETag");
+
+  ctrl.clearButtons();
+}
+
+void test_events_stream_telemetry(void) {
+  if (WiFi.status() != WL_AP_LISTENING) {
+    TEST_ASSERT_TRUE(ctrl.beginAP());
+  }
+
+  // The stream never ends; pumping for 500 ms covers at least one 200 ms tick
+  String resp = httpGetAndPump("/events", 500);
+  TEST_ASSERT_TRUE_MESSAGE(resp.indexOf("200 OK") >= 0, "No 200 OK for /events");
+  TEST_ASSERT_TRUE_MESSAGE(resp.indexOf("text/event-stream") >= 0, "Wrong content type");
+  TEST_ASSERT_TRUE_MESSAGE(resp.indexOf("data: {\"l\":") >= 0, "No telemetry event");
+  TEST_ASSERT_TRUE_MESSAGE(resp.indexOf("\"hz\":") >= 0, "Loop stats missing");
+
+  // Let update() notice the closed stream and free its slot
+  for (uint8_t i = 0; i < 50; i++) { ctrl.update(); delay(1); }
+}
+
+void test_metrics_endpoint(void) {
+  if (WiFi.status() != WL_AP_LISTENING) {
+    TEST_ASSERT_TRUE(ctrl.beginAP());
+  }
+
+  httpGetAndPump("/health");
+  String resp = httpGetAndPump("/metrics");
+#if CONTROLLER_METRICS
+  TEST_ASSERT_TRUE_MESSAGE(resp.indexOf("200 OK") >= 0, "No 200 OK for /metrics");
+  TEST_ASSERT_TRUE_MESSAGE(resp.indexOf("# TYPE controller_request_phase_seconds histogram") >= 0, "No histogram");
+  TEST_ASSERT_TRUE_MESSAGE(resp.indexOf("route=\"other\",phase=\"handler\",le=\"+Inf\"") >= 0,
+                           "/health not recorded");
+#else
+  TEST_ASSERT_TRUE_MESSAGE(resp.indexOf("404") >= 0, "/metrics served with CONTROLLER_METRICS=0");
+#endif
+}
+
 // If you added /health endpoint
 void test_health_endpoint_ok(void) {
   if (WiFi.status() != WL_AP_LISTENING) {
@@ -101,11 +203,112 @@ void test_health_endpoint_ok(void) {
   TEST_ASSERT_TRUE_MESSAGE(resp.indexOf("OK") >= 0, "Body missing OK");
 }
 
+static int countOccurrences(const String& s, const char* needle) {
+  int n = 0;
+  int pos = s.indexOf(needle);
+  while (pos >= 0) {
+    n++;
+    pos = s.indexOf(needle, pos + 1);
+  }
+  return n;
+}
+
+void test_drive_keep_alive_pipelined(void) {
+  if (WiFi.status() != WL_AP_LISTENING) {
+    TEST_ASSERT_TRUE(ctrl.beginAP());
+  }
+
+  IPAddress ip = WiFi.localIP();
+  WiFiClient c;
+  TEST_ASSERT_TRUE_MESSAGE(c.connect(ip, 80), "Failed to connect to server:80");
+
+  // Two requests back to back on one socket, no Connection: close
+  c.print("GET /drive?x=0&y=0&t=100 HTTP/1.1\r\nHost: robot\r\n\r\n"
+          "GET /drive?x=0&y=0&t=100 HTTP/1.1\r\nHost: robot\r\n\r\n");
+
+  String resp;
+  const unsigned long t0 = millis();
+  while (millis() - t0 < 1000 && countOccurrences(resp, "200 OK") < 2) {
+    ctrl.update();
+    while (c.available()) resp += (char)c.read();
+    delay(1);
+  }
+
+  TEST_ASSERT_EQUAL_INT_MESSAGE(2, countOccurrences(resp, "200 OK"), "Expected two pipelined responses");
+  TEST_ASSERT_TRUE_MESSAGE(resp.indexOf("Connection: keep-alive") >= 0, "Response did not keep the connection");
+  TEST_ASSERT_TRUE_MESSAGE(c.connected(), "Server closed a keep-alive connection");
+  c.stop();
+}
+
+void test_websocket_upgrade(void) {
+  if (WiFi.status() != WL_AP_LISTENING) {
+    TEST_ASSERT_TRUE(ctrl.beginAP());
+  }
+
+  IPAddress ip = WiFi.localIP();
+  WiFiClient c;
+  TEST_ASSERT_TRUE_MESSAGE(c.connect(ip, 80), "Failed to connect to server:80");
+
+  // Sample key from RFC 6455 section 1.3
+  c.print("GET /ws HTTP/1.1\r\nHost: robot\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+          "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\nSec-WebSocket-Version: 13\r\n\r\n");
+
+  String resp;
+  const unsigned long t0 = millis();
+  while (millis() - t0 < 1000 && resp.indexOf("\r\n\r\n") < 0) {
+    ctrl.update();
+    while (c.available()) resp += (char)c.read();
+    delay(1);
+  }
+
+  TEST_ASSERT_TRUE_MESSAGE(resp.indexOf("101 Switching Protocols") >= 0, "No 101 for /ws");
+  TEST_ASSERT_TRUE_MESSAGE(resp.indexOf("s3pPLMBiTxaQ9kYGzzhZRbK+xOo=") >= 0, "Wrong Sec-WebSocket-Accept");
+  c.stop();
+}
+
+void test_websocket_telemetry_frames(void) {
+  if (WiFi.status() != WL_AP_LISTENING) {
+    TEST_ASSERT_TRUE(ctrl.beginAP());
+  }
+
+  IPAddress ip = WiFi.localIP();
+  WiFiClient c;
+  TEST_ASSERT_TRUE_MESSAGE(c.connect(ip, 80), "Failed to connect to server:80");
+
+  c.print("GET /ws HTTP/1.1\r\nHost: robot\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+          "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\nSec-WebSocket-Version: 13\r\n\r\n");
+
+  // Subscribe: masked binary frame {0x04, 0x01} with an all-zero mask
+  const uint8_t subscribe[] = { 0x82, 0x82, 0, 0, 0, 0, 0x04, 0x01 };
+  c.write(subscribe, sizeof(subscribe));
+
+  // Telemetry arrives as text frames (0x81) carrying the /events JSON
+  String resp;
+  const unsigned long t0 = millis();
+  while (millis() - t0 < 1000 && resp.indexOf("\"hz\":") < 0) {
+    ctrl.update();
+    while (c.available()) resp += (char)c.read();
+    delay(1);
+  }
+
+  TEST_ASSERT_TRUE_MESSAGE(resp.indexOf((char)0x81) >= 0, "No text frame on /ws");
+  TEST_ASSERT_TRUE_MESSAGE(resp.indexOf("{\"l\":") >= 0, "No telemetry on /ws");
+  c.stop();
+}
+
 int runUnityTests() {
   UNITY_BEGIN();
   RUN_TEST(test_begin_ap_starts_listening);
   RUN_TEST(test_root_returns_html);
   RUN_TEST(test_control_triggers_callback);
+  RUN_TEST(test_ui_manifest_lists_buttons);
+  RUN_TEST(test_root_inlines_widgets);
+  RUN_TEST(test_root_conditional_get);
+  RUN_TEST(test_events_stream_telemetry);
+  RUN_TEST(test_metrics_endpoint);
+  RUN_TEST(test_drive_keep_alive_pipelined);
+  RUN_TEST(test_websocket_upgrade);
+  RUN_TEST(test_websocket_telemetry_frames);
 
   // Comment this out if you didn't add /health
   // RUN_TEST(test_health_endpoint_ok);
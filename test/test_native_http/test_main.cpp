@@ -0,0 +1,363 @@
+// Host-side tests for the pure HTTP pieces of the Controller library.
+// Run with: pio test -e native
+
+#include <stdlib.h>
+#include <string.h>
+#include <unity.h>
+
+#include "HttpRequestParser.h"
+#include "LatencyHistogram.h"
+#include "LoopProfiler.h"
+#include "ResponseWriter.h"
+#include "Template.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static HttpRequestParser::State feedAll(HttpRequestParser& p, const char* bytes) {
+  while (*bytes && !p.done()) p.feed(*bytes++);
+  return p.state();
+}
+
+void test_parses_drive_query(void) {
+  HttpRequestParser p;
+  TEST_ASSERT_EQUAL(HttpRequestParser::COMPLETE,
+                    feedAll(p, "GET /drive?x=-12&y=40&t=100&_=1739300000 HTTP/1.1\r\nHost: robot\r\n\r\n"));
+
+  const HttpRequest& req = p.request();
+  TEST_ASSERT_TRUE(req.isGet("/drive"));
+  TEST_ASSERT_EQUAL_UINT8(4, req.paramCount);
+
+  int x = 0, y = 0, t = 0;
+  TEST_ASSERT_TRUE(req.paramInt("x", x));
+  TEST_ASSERT_TRUE(req.paramInt("y", y));
+  TEST_ASSERT_TRUE(req.paramInt("t", t));
+  TEST_ASSERT_EQUAL_INT(-12, x);
+  TEST_ASSERT_EQUAL_INT(40, y);
+  TEST_ASSERT_EQUAL_INT(100, t);
+}
+
+void test_decodes_plus_and_percent(void) {
+  HttpRequestParser p;
+  feedAll(p, "GET /control?msg=hello+world%21&id= HTTP/1.1\r\n\r\n");
+
+  const HttpRequest& req = p.request();
+  TEST_ASSERT_EQUAL_STRING("hello world!", req.param("msg"));
+
+  int id = 7;
+  TEST_ASSERT_FALSE(req.paramInt("id", id));   // present but empty
+  TEST_ASSERT_EQUAL_INT(7, id);
+  TEST_ASSERT_NULL(req.param("missing"));
+}
+
+void test_incremental_feed_and_pipelining(void) {
+  // Two requests arrive in one buffer; the parser stops at the end of the first
+  const char* wire = "GET /btn?id=1 HTTP/1.1\r\n\r\nGET /sld?id=0&v=42 HTTP/1.1\r\nConnection: close\r\n\r\n";
+  HttpRequestParser p;
+
+  const char* c = wire;
+  while (*c && !p.done()) p.feed(*c++);
+  TEST_ASSERT_TRUE(p.request().isGet("/btn"));
+  TEST_ASSERT_TRUE(p.keepAliveRequested());
+
+  p.reset();
+  while (*c && !p.done()) p.feed(*c++);
+  TEST_ASSERT_TRUE(p.request().isGet("/sld"));
+  TEST_ASSERT_FALSE(p.keepAliveRequested());
+  TEST_ASSERT_EQUAL_STRING("42", p.request().param("v"));
+}
+
+void test_http10_needs_explicit_keep_alive(void) {
+  HttpRequestParser p;
+  feedAll(p, "GET /drive HTTP/1.0\r\n\r\n");
+  TEST_ASSERT_FALSE(p.keepAliveRequested());
+
+  p.reset();
+  feedAll(p, "GET /drive HTTP/1.0\r\nConnection: Keep-Alive\r\n\r\n");
+  TEST_ASSERT_TRUE(p.keepAliveRequested());
+}
+
+void test_websocket_upgrade_headers(void) {
+  HttpRequestParser p;
+  feedAll(p, "GET /ws HTTP/1.1\r\nUpgrade: websocket\r\nConnection: keep-alive, Upgrade\r\n"
+             "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n\r\n");
+  TEST_ASSERT_TRUE(p.webSocketUpgradeRequested());
+  TEST_ASSERT_EQUAL_STRING("dGhlIHNhbXBsZSBub25jZQ==", p.webSocketKey());
+}
+
+void test_if_none_match(void) {
+  HttpRequestParser p;
+  feedAll(p, "GET / HTTP/1.1\r\nIf-None-Match: \"old\", W/\"24736a8e-0badf00d\"\r\n\r\n");
+  TEST_ASSERT_TRUE(p.request().etagMatches("\"24736a8e-0badf00d\""));
+  TEST_ASSERT_FALSE(p.request().etagMatches("\"24736a8e\""));
+
+  p.reset();
+  feedAll(p, "GET / HTTP/1.1\r\nIf-None-Match: *\r\n\r\n");
+  TEST_ASSERT_TRUE(p.request().etagMatches("\"anything\""));
+
+  p.reset();
+  feedAll(p, "GET / HTTP/1.1\r\n\r\n");
+  TEST_ASSERT_FALSE(p.request().etagMatches("\"24736a8e\""));
+}
+
+void test_accept_encoding_gzip_quality(void) {
+  HttpRequestParser p;
+  feedAll(p, "GET / HTTP/1.1\r\nAccept-Encoding: gzip, deflate, br\r\n\r\n");
+  TEST_ASSERT_TRUE(p.request().acceptsGzip);
+
+  p.reset();
+  feedAll(p, "GET / HTTP/1.1\r\nAccept-Encoding: br, GZIP;q=0.5\r\n\r\n");
+  TEST_ASSERT_TRUE(p.request().acceptsGzip);
+
+  p.reset();
+  feedAll(p, "GET / HTTP/1.1\r\nAccept-Encoding: gzip;q=0, identity\r\n\r\n");
+  TEST_ASSERT_FALSE(p.request().acceptsGzip);
+
+  p.reset();
+  feedAll(p, "GET / HTTP/1.1\r\nAccept-Encoding: br;q=1, gzip; q=0.000\r\n\r\n");
+  TEST_ASSERT_FALSE(p.request().acceptsGzip);
+
+  p.reset();
+  feedAll(p, "GET / HTTP/1.1\r\nAccept-Encoding: x-gzip\r\n\r\n");
+  TEST_ASSERT_FALSE(p.request().acceptsGzip);
+}
+
+void test_overlong_request_line_is_an_error(void) {
+  HttpRequestParser p;
+  p.feed('G');
+  for (uint16_t i = 0; i < HttpRequestParser::MAX_REQUEST_LINE + 1; i++) p.feed('a');
+  TEST_ASSERT_EQUAL(HttpRequestParser::ERROR, p.state());
+}
+
+// Records every sink call the way WiFiClient::write would reach the modem
+struct CountingSink {
+  uint16_t calls = 0;
+  size_t total = 0;
+  char data[4096];
+};
+
+static size_t countingWrite(void* ctx, const uint8_t* data, size_t len) {
+  CountingSink* s = static_cast<CountingSink*>(ctx);
+  if (s->total + len < sizeof(s->data)) memcpy(s->data + s->total, data, len);
+  s->calls++;
+  s->total += len;
+  s->data[s->total < sizeof(s->data) ? s->total : sizeof(s->data) - 1] = '\0';
+  return len;
+}
+
+void test_small_response_is_one_write(void) {
+  CountingSink sink;
+  uint8_t buf[512];
+  ResponseWriter w(buf, sizeof(buf), countingWrite, &sink);
+
+  // Same shape as the /drive acknowledgement
+  w.status(200, "OK");
+  w.header("Content-Type", "text/plain; charset=utf-8");
+  w.header("Connection", "keep-alive");
+  w.header("Content-Length", 2UL);
+  w.endHeaders();
+  w.print("OK");
+  TEST_ASSERT_EQUAL_UINT16(0, sink.calls);   // nothing leaves before flush()
+  w.flush();
+
+  TEST_ASSERT_EQUAL_UINT16(1, sink.calls);
+  TEST_ASSERT_EQUAL_STRING("HTTP/1.1 200 OK\r\n"
+                           "Content-Type: text/plain; charset=utf-8\r\n"
+                           "Connection: keep-alive\r\n"
+                           "Content-Length: 2\r\n"
+                           "\r\nOK", sink.data);
+}
+
+void test_large_body_is_two_writes(void) {
+  CountingSink sink;
+  uint8_t buf[512];
+  ResponseWriter w(buf, sizeof(buf), countingWrite, &sink);
+
+  static uint8_t page[3000];
+  for (size_t i = 0; i < sizeof(page); i++) page[i] = (uint8_t)('a' + i % 26);
+
+  w.status(200, "OK");
+  w.header("Content-Length", (unsigned long)sizeof(page));
+  w.endHeaders();
+  w.write(page, sizeof(page));
+  w.flush();
+
+  // A full buffer (headers + start of body), then the rest in one piece
+  TEST_ASSERT_EQUAL_UINT16(2, sink.calls);
+  TEST_ASSERT_EQUAL_UINT32(sizeof(page), sink.total - strlen("HTTP/1.1 200 OK\r\nContent-Length: 3000\r\n\r\n"));
+  TEST_ASSERT_EQUAL_UINT32(sink.total, w.bytesWritten());
+}
+
+void test_many_small_prints_coalesce(void) {
+  CountingSink sink;
+  uint8_t buf[64];
+  ResponseWriter w(buf, sizeof(buf), countingWrite, &sink);
+
+  // 200 single characters through a 64-byte buffer: ceil(200 / 64) writes
+  for (uint8_t i = 0; i < 200; i++) w.print((char)('0' + i % 10));
+  w.print(-1234L);
+  w.flush();
+
+  TEST_ASSERT_EQUAL_UINT16(4, sink.calls);
+  TEST_ASSERT_EQUAL_UINT32(205, sink.total);
+  TEST_ASSERT_EQUAL_STRING("-1234", sink.data + 200);
+}
+
+static void listGenerator(void* ctx, uint8_t slot, ResponseWriter& out) {
+  // slot 0: a number, slot 1: as many entries as *ctx says
+  if (slot == 0) {
+    out.print(100);
+    return;
+  }
+  const int n = *static_cast<int*>(ctx);
+  for (int i = 0; i < n; i++) {
+    if (i) out.print(',');
+    out.print(i);
+  }
+}
+
+void test_template_renders_chunked(void) {
+  static const TemplateFragment tpl[] = {
+    { "{\"t\":", 0, 0 },
+    { ",\"ids\":[", 0, 1 },
+    { "]}", 0, TEMPLATE_NO_SLOT },
+  };
+
+  CountingSink sink;
+  uint8_t buf[512];
+  ResponseWriter w(buf, sizeof(buf), countingWrite, &sink);
+  int entries = 3;
+
+  w.status(200, "OK");
+  w.header("Transfer-Encoding", "chunked");
+  w.endHeaders();
+  w.beginChunked();
+  renderTemplate(tpl, 3, listGenerator, &entries, w);
+  w.finish();
+
+  // Headers, the single chunk and the terminator leave in one write
+  TEST_ASSERT_EQUAL_UINT16(1, sink.calls);
+  TEST_ASSERT_EQUAL_STRING("HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n"
+                           "0017\r\n{\"t\":100,\"ids\":[0,1,2]}\r\n0\r\n\r\n", sink.data);
+}
+
+void test_chunked_output_is_bounded_by_buffer(void) {
+  static const TemplateFragment tpl[] = {
+    { "[", 0, 1 },
+    { "]", 0, TEMPLATE_NO_SLOT },
+  };
+
+  CountingSink sink;
+  uint8_t buf[64];
+  ResponseWriter w(buf, sizeof(buf), countingWrite, &sink);
+  int entries = 400;   // ~1.5 KB of output through a 64-byte buffer
+
+  w.beginChunked();
+  renderTemplate(tpl, 2, listGenerator, &entries, w);
+  w.finish();
+
+  // Walk the chunks: every one fits the buffer and the sizes add up
+  const char* p = sink.data;
+  size_t body = 0;
+  for (;;) {
+    char* end = nullptr;
+    const unsigned long n = strtoul(p, &end, 16);
+    TEST_ASSERT_EQUAL_STRING_LEN("\r\n", end, 2);
+    if (n == 0) break;
+    TEST_ASSERT_TRUE(n <= sizeof(buf));
+    body += n;
+    p = end + 2 + n;
+    TEST_ASSERT_EQUAL_STRING_LEN("\r\n", p, 2);
+    p += 2;
+  }
+  TEST_ASSERT_EQUAL_UINT32(1489 + 2, body);   // "0,1,...,399" plus the brackets
+}
+
+void test_latency_buckets_are_log4(void) {
+  TEST_ASSERT_EQUAL_UINT8(0, LatencyHistogram::bucketFor(0));
+  TEST_ASSERT_EQUAL_UINT8(0, LatencyHistogram::bucketFor(16));
+  TEST_ASSERT_EQUAL_UINT8(1, LatencyHistogram::bucketFor(17));
+  TEST_ASSERT_EQUAL_UINT8(1, LatencyHistogram::bucketFor(64));
+  TEST_ASSERT_EQUAL_UINT8(2, LatencyHistogram::bucketFor(65));
+  TEST_ASSERT_EQUAL_UINT8(8, LatencyHistogram::bucketFor(1048576));
+  TEST_ASSERT_EQUAL_UINT8(LatencyHistogram::BOUNDED_BUCKETS, LatencyHistogram::bucketFor(1048577));
+  TEST_ASSERT_EQUAL_UINT8(LatencyHistogram::BOUNDED_BUCKETS, LatencyHistogram::bucketFor(0xFFFFFFFFUL));
+}
+
+void test_prometheus_histogram_text(void) {
+  LatencyHistogram h;
+  h.record(10);        // <= 16 us
+  h.record(500);       // <= 1024 us
+  h.record(2000000);   // +Inf
+
+  CountingSink sink;
+  uint8_t buf[2048];
+  ResponseWriter w(buf, sizeof(buf), countingWrite, &sink);
+  writePrometheusHistogram(w, "x_seconds", "route=\"drive\"", h);
+  w.flush();
+
+  // Buckets are cumulative and bounded in seconds
+  TEST_ASSERT_NOT_NULL(strstr(sink.data, "x_seconds_bucket{route=\"drive\",le=\"0.000016\"} 1\n"));
+  TEST_ASSERT_NOT_NULL(strstr(sink.data, "x_seconds_bucket{route=\"drive\",le=\"0.000256\"} 1\n"));
+  TEST_ASSERT_NOT_NULL(strstr(sink.data, "x_seconds_bucket{route=\"drive\",le=\"0.001024\"} 2\n"));
+  TEST_ASSERT_NOT_NULL(strstr(sink.data, "x_seconds_bucket{route=\"drive\",le=\"1.048576\"} 2\n"));
+  TEST_ASSERT_NOT_NULL(strstr(sink.data, "x_seconds_bucket{route=\"drive\",le=\"+Inf\"} 3\n"));
+  TEST_ASSERT_NOT_NULL(strstr(sink.data, "x_seconds_sum{route=\"drive\"} 2.000510\n"));
+  TEST_ASSERT_NOT_NULL(strstr(sink.data, "x_seconds_count{route=\"drive\"} 3\n"));
+}
+
+void test_loop_profiler_stats_and_overrun(void) {
+  LoopProfiler p(2);
+  p.setBudgetUs(5000);
+
+  // 199 loops of 1 ms (100 us in section 0, 50 us in section 1), one 300 ms stall
+  uint32_t t = 0;
+  for (int i = 0; i < 200; i++) {
+    p.loopStart(t);
+    p.mark(0, t + 100);
+    p.mark(1, t + 150);
+    t += (i == 100) ? 300000 : 1000;
+  }
+  p.loopStart(t);
+
+  TEST_ASSERT_EQUAL_UINT32(200, p.loops());
+  TEST_ASSERT_EQUAL_UINT32(1000, p.minUs());
+  TEST_ASSERT_EQUAL_UINT32(300000, p.maxUs());
+  TEST_ASSERT_EQUAL_UINT32((199UL * 1000 + 300000) / 200, p.meanUs());
+  TEST_ASSERT_EQUAL_UINT32(1, p.overruns());
+
+  // p99 is a bucket bound: at least the true value, at most 25% above it
+  TEST_ASSERT_TRUE(p.percentileUs(99) >= 1000 && p.percentileUs(99) <= 1250);
+
+  CountingSink sink;
+  uint8_t buf[1024];
+  ResponseWriter w(buf, sizeof(buf), countingWrite, &sink);
+  static const char* const names[] = { "a", "b" };
+  p.writeSummary(w, names);
+  w.flush();
+  TEST_ASSERT_NOT_NULL(strstr(sink.data, "overruns=1\n"));
+  TEST_ASSERT_NOT_NULL(strstr(sink.data, "worst: #101 300000 100 50 299850\n"));
+}
+
+int main(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_parses_drive_query);
+  RUN_TEST(test_decodes_plus_and_percent);
+  RUN_TEST(test_incremental_feed_and_pipelining);
+  RUN_TEST(test_http10_needs_explicit_keep_alive);
+  RUN_TEST(test_websocket_upgrade_headers);
+  RUN_TEST(test_if_none_match);
+  RUN_TEST(test_accept_encoding_gzip_quality);
+  RUN_TEST(test_overlong_request_line_is_an_error);
+  RUN_TEST(test_small_response_is_one_write);
+  RUN_TEST(test_large_body_is_two_writes);
+  RUN_TEST(test_many_small_prints_coalesce);
+  RUN_TEST(test_template_renders_chunked);
+  RUN_TEST(test_chunked_output_is_bounded_by_buffer);
+  RUN_TEST(test_latency_buckets_are_log4);
+  RUN_TEST(test_prometheus_histogram_text);
+  RUN_TEST(test_loop_profiler_stats_and_overrun);
+  return UNITY_END();
+}
@@ -0,0 +1,173 @@
+// Host-side tests for ramping, drive mixing and the stick/PWM tables.
+// Run with: pio test -e native
+
+#include <unity.h>
+
+#include "DriveKinematics.h"
+#include "MotionProfile.h"
+#include "ResponseCurve.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// Output after rampMs of updates every periodUs toward target
+static int8_t rampFor(SlewLimiter& s, int8_t target, uint32_t periodUs, uint32_t rampMs) {
+  for (uint32_t t = 0; t < rampMs * 1000; t += periodUs) s.step(target, periodUs);
+  return s.output();
+}
+
+void test_slew_is_independent_of_loop_rate(void) {
+  // 400 units/s: 100 ms of ramping is 40 units at 5 kHz, 1 kHz and 50 Hz
+  SlewLimiter fast, medium, slow;
+  TEST_ASSERT_EQUAL_INT8(40, rampFor(fast, 100, 200, 100));
+  TEST_ASSERT_EQUAL_INT8(40, rampFor(medium, 100, 1000, 100));
+  TEST_ASSERT_EQUAL_INT8(40, rampFor(slow, 100, 20000, 100));
+
+  // Braking to zero uses the brake rate: 1500 units/s clears 40 in < 30 ms
+  TEST_ASSERT_EQUAL_INT8(0, rampFor(medium, 0, 1000, 30));
+}
+
+void test_slew_decel_and_stall_clamp(void) {
+  SlewLimiter s;
+  s.setRates(100, 200, 1000);
+  s.reset(80);
+
+  // Slowing toward a non-zero target uses decel
+  TEST_ASSERT_EQUAL_INT8(60, rampFor(s, 20, 1000, 100));
+
+  // A 2 s stall only ramps 100 ms worth (accel: 10 units)
+  s.reset(0);
+  s.step(100, 2000000);
+  TEST_ASSERT_EQUAL_INT8(10, s.output());
+}
+
+void test_scurve_eases_in_and_out(void) {
+  // accel 400 units/s, jerk 4000 units/s^2: the rate needs 100 ms to build
+  SlewLimiter s;
+  s.setJerk(4000);
+
+  // After 50 ms a plain ramp is at 20; the S-curve has only covered 5
+  TEST_ASSERT_EQUAL_INT8(5, rampFor(s, 100, 1000, 50));
+
+  // Lands exactly on the target, never above it
+  int8_t peak = 0;
+  for (int i = 0; i < 1000; i++) {
+    const int8_t v = s.step(100, 1000);
+    if (v > peak) peak = v;
+  }
+  TEST_ASSERT_EQUAL_INT8(100, peak);
+  TEST_ASSERT_EQUAL_INT8(100, s.output());
+
+  // Braking is still the straight 1500 units/s ramp
+  TEST_ASSERT_EQUAL_INT8(55, rampFor(s, 0, 1000, 30));
+}
+
+static DriveInput stick(int x, int y, int r, int t) {
+  DriveInput in;
+  in.x = x;
+  in.y = y;
+  in.r = r;
+  in.t = t;
+  return in;
+}
+
+void test_drive_mixing_modes(void) {
+  int8_t out[DRIVE_MAX_MOTORS];
+
+  // Arcade keeps the original per-side clamp, then throttle
+  TEST_ASSERT_EQUAL_UINT8(2, mixDrive(DRIVE_ARCADE, stick(50, 80, 0, 50), out));
+  TEST_ASSERT_EQUAL_INT8(50, out[0]);
+  TEST_ASSERT_EQUAL_INT8(15, out[1]);
+
+  // Tank: y is the left stick, r the right one
+  mixDrive(DRIVE_TANK, stick(90, 60, -40, 100), out);
+  TEST_ASSERT_EQUAL_INT8(60, out[0]);
+  TEST_ASSERT_EQUAL_INT8(-40, out[1]);
+
+  // Curvature: the same stick turns less at half speed, spins when stopped
+  mixDrive(DRIVE_CURVATURE, stick(40, 50, 0, 100), out);
+  TEST_ASSERT_EQUAL_INT8(70, out[0]);
+  TEST_ASSERT_EQUAL_INT8(30, out[1]);
+  mixDrive(DRIVE_CURVATURE, stick(40, 0, 0, 100), out);
+  TEST_ASSERT_EQUAL_INT8(40, out[0]);
+  TEST_ASSERT_EQUAL_INT8(-40, out[1]);
+
+  // Mecanum: forward + strafe + rotate is scaled down as a whole
+  TEST_ASSERT_EQUAL_UINT8(4, mixDrive(DRIVE_MECANUM, stick(100, 100, 100, 100), out));
+  TEST_ASSERT_EQUAL_INT8(100, out[0]);
+  TEST_ASSERT_EQUAL_INT8(-33, out[1]);
+  TEST_ASSERT_EQUAL_INT8(33, out[2]);
+  TEST_ASSERT_EQUAL_INT8(33, out[3]);
+}
+
+void test_curvature_is_continuous_at_low_speed(void) {
+  // Full turn while sweeping forward speed through the quick-turn band:
+  // no step between neighbouring speeds may be larger than the spin slope
+  int8_t prev[DRIVE_MAX_MOTORS];
+  int8_t out[DRIVE_MAX_MOTORS];
+  mixDrive(DRIVE_CURVATURE, stick(100, -100, 0, 100), prev);
+  for (int y = -99; y <= 100; y++) {
+    mixDrive(DRIVE_CURVATURE, stick(100, y, 0, 100), out);
+    for (uint8_t i = 0; i < 2; i++) {
+      const int step = out[i] - prev[i];
+      TEST_ASSERT_TRUE_MESSAGE(step <= 12 && step >= -12, "curvature output jumped");
+      prev[i] = out[i];
+    }
+  }
+
+  // Either side of the old threshold the outputs are close together
+  mixDrive(DRIVE_CURVATURE, stick(100, 9, 0, 100), out);
+  TEST_ASSERT_INT_WITHIN(10, 20, out[0]);
+  TEST_ASSERT_INT_WITHIN(10, 0, out[1]);
+  mixDrive(DRIVE_CURVATURE, stick(100, 10, 0, 100), out);
+  TEST_ASSERT_EQUAL_INT8(20, out[0]);
+  TEST_ASSERT_EQUAL_INT8(0, out[1]);
+}
+
+void test_input_curve_deadband_and_shape(void) {
+  CurveTable c;
+
+  // Linear with a deadband of 10: no jump at the edge, full scale at the end
+  buildInputCurve(CURVE_LINEAR, 10, c);
+  TEST_ASSERT_EQUAL_INT8(0, c(9));
+  TEST_ASSERT_EQUAL_INT8(0, c(10));
+  TEST_ASSERT_EQUAL_INT8(1, c(11));
+  TEST_ASSERT_EQUAL_INT8(50, c(55));
+  TEST_ASSERT_EQUAL_INT8(-100, c(-100));
+
+  // Expo and cubic soften the middle and keep the ends
+  buildInputCurve(CURVE_EXPO, 0, c);
+  TEST_ASSERT_EQUAL_INT8(31, c(50));
+  TEST_ASSERT_EQUAL_INT8(100, c(100));
+  buildInputCurve(CURVE_CUBIC, 0, c);
+  TEST_ASSERT_EQUAL_INT8(-13, c(-50));
+}
+
+void test_pwm_table_scales_above_min(void) {
+  uint16_t duty[101];
+  buildPwmTable(0, duty);
+  TEST_ASSERT_EQUAL_UINT16(0, duty[0]);
+  TEST_ASSERT_EQUAL_UINT16(32768, duty[50]);
+  TEST_ASSERT_EQUAL_UINT16(MOTOR_DUTY_MAX, duty[100]);
+
+  // Low speeds stay distinct instead of all clamping to the minimum
+  buildPwmTable(90, duty);
+  TEST_ASSERT_EQUAL_UINT16(0, duty[0]);
+  TEST_ASSERT_EQUAL_UINT16(23130 + 424, duty[1]);   // 90 * 257 + 1%
+  TEST_ASSERT_EQUAL_UINT8(92, duty[1] >> 8);        // analogWrite() value
+  TEST_ASSERT_EQUAL_UINT16(MOTOR_DUTY_MAX, duty[100]);
+}
+
+int main(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_slew_is_independent_of_loop_rate);
+  RUN_TEST(test_slew_decel_and_stall_clamp);
+  RUN_TEST(test_scurve_eases_in_and_out);
+  RUN_TEST(test_drive_mixing_modes);
+  RUN_TEST(test_curvature_is_continuous_at_low_speed);
+  RUN_TEST(test_input_curve_deadband_and_shape);
+  RUN_TEST(test_pwm_table_scales_above_min);
+  return UNITY_END();
+}
@@ -0,0 +1,171 @@
+// Host-side tests for the GPT PWM setup, run against a model of one GPT
+// channel's registers. Run with: pio test -e native
+
+#include <unity.h>
+
+#include "GptPwm.h"
+#include "ResponseCurve.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static const uint32_t kPclkd = 48000000;
+
+// The registers gptPwmConfigure()/gptPwmSetDuty() touch, with the buffer
+// transfers the hardware does at the end of each period.
+struct FakeGpt {
+  uint32_t GTWP = 0, GTCR = 0, GTUDDTYC = 0, GTIOR = 0, GTBER = 0, GTCNT = 0;
+  uint32_t GTCCR[6] = {};
+  uint32_t GTPR = 0xFFFFFFFF, GTPBR = 0;
+
+  void cycleEnd() {
+    if (!(GTCR & GPT_GTCR_CST)) return;
+    if (GTBER & (1UL << 16)) GTCCR[GPT_CCR_A] = GTCCR[GPT_CCR_C];
+    if (GTBER & (1UL << 18)) GTCCR[GPT_CCR_B] = GTCCR[GPT_CCR_D];
+    if (GTBER & (1UL << 20)) GTPR = GTPBR;
+  }
+
+  // Counts per period the output is high (saw-wave, high until compare)
+  uint32_t highCounts(bool outputA) const {
+    const uint8_t shift = outputA ? GPT_GTUDDTYC_OADTY_SHIFT : GPT_GTUDDTYC_OBDTY_SHIFT;
+    const uint32_t forced = (GTUDDTYC >> shift) & 3;
+    if (forced == GPT_DUTY_0) return 0;
+    if (forced == GPT_DUTY_100) return GTPR + 1;
+    const uint32_t ccr = GTCCR[outputA ? GPT_CCR_A : GPT_CCR_B];
+    return ccr > GTPR ? GTPR + 1 : ccr;
+  }
+
+  bool outputEnabled(bool outputA) const {
+    const uint32_t bits = (GPT_GTIOR_PWM | GPT_GTIOR_OAE) << (outputA ? 0 : GPT_GTIOR_B_SHIFT);
+    return (GTIOR & bits) == bits;
+  }
+};
+
+void test_timing_20khz_has_11_bits(void) {
+  GptPwmTiming t;
+  TEST_ASSERT_TRUE(gptPwmTiming(kPclkd, 20000, 0xFFFF, t));
+  TEST_ASSERT_EQUAL_UINT8(0, t.prescaler);
+  TEST_ASSERT_EQUAL_UINT32(2400, t.periodCounts);
+  TEST_ASSERT_EQUAL_UINT8(11, t.resolutionBits);
+
+  TEST_ASSERT_TRUE(gptPwmTiming(kPclkd, 10000, 0xFFFF, t));
+  TEST_ASSERT_EQUAL_UINT8(12, t.resolutionBits);
+}
+
+void test_timing_picks_prescaler_for_slow_rates(void) {
+  GptPwmTiming t;
+  // 480000 counts does not fit a 16-bit counter: /16 gives 30000
+  TEST_ASSERT_TRUE(gptPwmTiming(kPclkd, 100, 0xFFFF, t));
+  TEST_ASSERT_EQUAL_UINT8(2, t.prescaler);
+  TEST_ASSERT_EQUAL_UINT32(30000, t.periodCounts);
+
+  // A 32-bit channel needs no prescaler
+  TEST_ASSERT_TRUE(gptPwmTiming(kPclkd, 100, 0xFFFFFFFF, t));
+  TEST_ASSERT_EQUAL_UINT8(0, t.prescaler);
+  TEST_ASSERT_EQUAL_UINT32(480000, t.periodCounts);
+
+  // Under 8 bits of resolution, or no frequency at all
+  TEST_ASSERT_FALSE(gptPwmTiming(kPclkd, 250000, 0xFFFF, t));
+  TEST_ASSERT_FALSE(gptPwmTiming(kPclkd, 0, 0xFFFF, t));
+}
+
+void test_duty_counts_round_and_hit_the_ends(void) {
+  TEST_ASSERT_EQUAL_UINT32(0, gptDutyCounts(0, 2400));
+  TEST_ASSERT_EQUAL_UINT32(2400, gptDutyCounts(0xFFFF, 2400));
+  TEST_ASSERT_EQUAL_UINT32(1200, gptDutyCounts(0x8000, 2400));   // 1200.02
+  TEST_ASSERT_EQUAL_UINT32(9, gptDutyCounts(257, 2400));         // 9.4, analogWrite 1
+  TEST_ASSERT_EQUAL_UINT32(1, gptDutyCounts(20, 2400));          // 0.73
+  TEST_ASSERT_EQUAL_UINT32(480000, gptDutyCounts(0xFFFF, 480000));
+}
+
+void test_low_speed_steps_finer_than_8_bits(void) {
+  // A high minimum leaves 55 analogWrite() levels for 100 speeds, so
+  // neighbouring commands collapse onto one duty. The 16-bit table keeps
+  // every step at 20 kHz, each smaller than one 8-bit level (period / 256).
+  GptPwmTiming t;
+  gptPwmTiming(kPclkd, 20000, 0xFFFF, t);
+  uint16_t duty[101];
+  buildPwmTable(200, duty);
+
+  bool collapsedIn8Bits = false;
+  for (uint8_t s = 1; s < 20; s++) {
+    const uint32_t lo = gptDutyCounts(duty[s], t.periodCounts);
+    const uint32_t hi = gptDutyCounts(duty[s + 1], t.periodCounts);
+    TEST_ASSERT_TRUE_MESSAGE(hi > lo, "adjacent speeds share a compare value");
+    TEST_ASSERT_TRUE_MESSAGE((hi - lo) * 256 < t.periodCounts, "step not finer than 8 bits");
+    if ((duty[s] >> 8) == (duty[s + 1] >> 8)) collapsedIn8Bits = true;
+  }
+  TEST_ASSERT_TRUE(collapsedIn8Bits);
+}
+
+void test_configure_sets_up_buffered_saw_pwm(void) {
+  FakeGpt r;
+  GptPwmTiming t;
+  gptPwmTiming(kPclkd, 20000, 0xFFFF, t);
+  gptPwmConfigure(r, t, true);
+
+  TEST_ASSERT_EQUAL_HEX32(GPT_GTWP_UNLOCK, r.GTWP);
+  TEST_ASSERT_EQUAL_HEX32(GPT_GTCR_CST, r.GTCR);   // saw-wave, PCLKD/1, running
+  TEST_ASSERT_EQUAL_UINT32(2399, r.GTPR);
+  TEST_ASSERT_EQUAL_HEX32(GPT_GTBER_BUFFERED, r.GTBER);
+  TEST_ASSERT_TRUE(r.GTUDDTYC & GPT_GTUDDTYC_UD);
+  TEST_ASSERT_TRUE(r.outputEnabled(true));
+  TEST_ASSERT_FALSE(r.outputEnabled(false));
+  TEST_ASSERT_EQUAL_UINT32(0, r.highCounts(true));   // starts stopped
+}
+
+void test_duty_changes_at_period_boundary(void) {
+  FakeGpt r;
+  GptPwmTiming t;
+  gptPwmTiming(kPclkd, 20000, 0xFFFF, t);
+  gptPwmConfigure(r, t, true);
+
+  gptPwmSetDuty(r, true, gptDutyCounts(100 * 257, t.periodCounts), t.periodCounts);
+  r.cycleEnd();
+  TEST_ASSERT_EQUAL_UINT32(941, r.highCounts(true));
+
+  // Mid-period write: the running period keeps its duty
+  gptPwmSetDuty(r, true, gptDutyCounts(200 * 257, t.periodCounts), t.periodCounts);
+  TEST_ASSERT_EQUAL_UINT32(941, r.highCounts(true));
+  r.cycleEnd();
+  TEST_ASSERT_EQUAL_UINT32(1882, r.highCounts(true));
+
+  gptPwmSetDuty(r, true, t.periodCounts, t.periodCounts);
+  TEST_ASSERT_EQUAL_UINT32(2400, r.highCounts(true));
+  gptPwmSetDuty(r, true, 0, t.periodCounts);
+  TEST_ASSERT_EQUAL_UINT32(0, r.highCounts(true));
+}
+
+void test_second_output_keeps_the_first_running(void) {
+  FakeGpt r;
+  GptPwmTiming t;
+  gptPwmTiming(kPclkd, 20000, 0xFFFF, t);
+  gptPwmConfigure(r, t, true);
+  gptPwmSetDuty(r, true, 1000, t.periodCounts);
+  r.cycleEnd();
+
+  gptPwmConfigure(r, t, false);
+  TEST_ASSERT_TRUE(r.outputEnabled(true));
+  TEST_ASSERT_TRUE(r.outputEnabled(false));
+  TEST_ASSERT_EQUAL_UINT32(1000, r.highCounts(true));
+  TEST_ASSERT_EQUAL_UINT32(0, r.highCounts(false));
+
+  gptPwmSetDuty(r, false, 500, t.periodCounts);
+  r.cycleEnd();
+  TEST_ASSERT_EQUAL_UINT32(1000, r.highCounts(true));
+  TEST_ASSERT_EQUAL_UINT32(500, r.highCounts(false));
+}
+
+int main(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_timing_20khz_has_11_bits);
+  RUN_TEST(test_timing_picks_prescaler_for_slow_rates);
+  RUN_TEST(test_duty_counts_round_and_hit_the_ends);
+  RUN_TEST(test_low_speed_steps_finer_than_8_bits);
+  RUN_TEST(test_configure_sets_up_buffered_saw_pwm);
+  RUN_TEST(test_duty_changes_at_period_boundary);
+  RUN_TEST(test_second_output_keeps_the_first_running);
+  return UNITY_END();
+}
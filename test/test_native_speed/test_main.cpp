@@ -0,0 +1,129 @@
+// Host-side tests for the closed-loop wheel speed controller, run against a
+// simulated DC motor + encoder. Run with: pio test -e native
+
+#include <unity.h>
+
+#include "SpeedControl.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// First-order motor: speed follows gain * output with time constant tauMs.
+// gain < 1 models a sagging battery or a stiffer side of the drivetrain.
+struct MotorPlant {
+  double gain;
+  double tauMs;
+  double topSpeed;     // counts per second at full output and gain 1
+  double speed = 0;    // counts per second
+  double position = 0; // counts
+
+  MotorPlant(double g, double tau = 80, double top = 6000) : gain(g), tauMs(tau), topSpeed(top) {}
+
+  void step(int8_t output, uint32_t dtUs) {
+    const double dt = dtUs / 1000.0;
+    const double target = gain * topSpeed * output / 100.0;
+    speed += (target - speed) * dt / (tauMs + dt);
+    position += speed * dtUs / 1e6;
+  }
+
+  int32_t encoder() const { return (int32_t)position; }
+  double percent() const { return speed * 100.0 / topSpeed; }
+};
+
+static const uint32_t kStepUs = 1000;   // 1 kHz control tick
+
+static WheelSpeedController makeController() {
+  WheelSpeedController c;
+  c.setMaxSpeed(6000);
+  return c;
+}
+
+// Runs ms of control at setpoint; returns the last drive output
+static int8_t run(WheelSpeedController& c, MotorPlant& m, int8_t setpoint, uint32_t ms) {
+  int8_t out = 0;
+  for (uint32_t t = 0; t < ms * 1000; t += kStepUs) {
+    out = c.step(setpoint, m.encoder(), kStepUs);
+    m.step(out, kStepUs);
+  }
+  return out;
+}
+
+void test_quadrature_counts_both_directions(void) {
+  QuadratureDecoder q;
+  q.begin(0);
+  // A leads B: AB 00 -> 10 -> 11 -> 01 -> 00 counts up
+  const uint8_t fwd[] = { 2, 3, 1, 0, 2, 3, 1, 0 };
+  for (uint8_t ab : fwd) q.update(ab);
+  TEST_ASSERT_EQUAL_INT32(8, q.count());
+
+  // Reverse, then a glitch (both pins at once) that must not count
+  const uint8_t rev[] = { 1, 3, 2, 0 };
+  for (uint8_t ab : rev) q.update(ab);
+  q.update(3);
+  TEST_ASSERT_EQUAL_INT32(4, q.count());
+}
+
+void test_closed_loop_holds_speed_with_weak_battery(void) {
+  // Open loop, 60% output on a 70% battery only reaches 42%
+  MotorPlant open(0.7);
+  for (int i = 0; i < 1000; i++) open.step(60, kStepUs);
+  TEST_ASSERT_INT_WITHIN(1, 42, (int)(open.percent() + 0.5));
+
+  // Closed loop settles on the setpoint
+  MotorPlant motor(0.7);
+  WheelSpeedController c = makeController();
+  run(c, motor, 60, 1500);
+  TEST_ASSERT_INT_WITHIN(2, 60, (int)(motor.percent() + 0.5));
+}
+
+void test_mismatched_wheels_track_straight(void) {
+  MotorPlant left(0.8), right(1.0, 120);
+  WheelSpeedController cl = makeController(), cr = makeController();
+
+  run(cl, left, 50, 1000);
+  run(cr, right, 50, 1000);
+  const double l0 = left.position, r0 = right.position;
+
+  // Over the next two seconds both wheels cover the same distance (within 2%)
+  run(cl, left, 50, 2000);
+  run(cr, right, 50, 2000);
+  const double dl = left.position - l0, dr = right.position - r0;
+  TEST_ASSERT_TRUE(dl > 5700 && dr > 5700);
+  TEST_ASSERT_TRUE((dl > dr ? dl - dr : dr - dl) < 0.02 * dr);
+}
+
+void test_saturation_does_not_wind_up(void) {
+  // 100% is out of reach on a half battery: output pinned at 100 for 2 s
+  MotorPlant motor(0.5);
+  WheelSpeedController c = makeController();
+  TEST_ASSERT_EQUAL_INT8(100, run(c, motor, 100, 2000));
+
+  // Dropping to 30% must not overshoot while a wound-up integral unwinds
+  int peak = 0;
+  for (int i = 0; i < 5; i++) {
+    run(c, motor, 30, 100);
+    if (i >= 2 && motor.percent() > peak) peak = (int)motor.percent();
+  }
+  TEST_ASSERT_TRUE(peak <= 33);
+  run(c, motor, 30, 1000);
+  TEST_ASSERT_INT_WITHIN(2, 30, (int)(motor.percent() + 0.5));
+}
+
+void test_zero_setpoint_is_immediate(void) {
+  MotorPlant motor(1.0);
+  WheelSpeedController c = makeController();
+  run(c, motor, 80, 500);
+  TEST_ASSERT_EQUAL_INT8(0, c.step(0, motor.encoder(), kStepUs));
+}
+
+int main(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_quadrature_counts_both_directions);
+  RUN_TEST(test_closed_loop_holds_speed_with_weak_battery);
+  RUN_TEST(test_mismatched_wheels_track_straight);
+  RUN_TEST(test_saturation_does_not_wind_up);
+  RUN_TEST(test_zero_setpoint_is_immediate);
+  return UNITY_END();
+}
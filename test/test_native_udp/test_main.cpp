@@ -0,0 +1,104 @@
+// Host-side tests for the UDP drive packet format and sequence filter.
+// Run with: pio test -e native
+
+#include <string.h>
+#include <unity.h>
+
+#include "UdpDrive.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_crc_check_value(void) {
+  // Standard CRC-16/CCITT-FALSE check value
+  const char* check = "123456789";
+  TEST_ASSERT_EQUAL_HEX16(0x29B1, crc16Ccitt((const uint8_t*)check, strlen(check)));
+}
+
+void test_packet_round_trip(void) {
+  UdpDrivePacket pkt;
+  pkt.x = -100;
+  pkt.y = 42;
+  pkt.t = 75;
+  pkt.seq = 0xBEEF;
+  pkt.clientMs = 0x12345678;
+
+  uint8_t buf[UDP_DRIVE_PACKET_SIZE];
+  encodeUdpDrivePacket(pkt, buf);
+  TEST_ASSERT_EQUAL_HEX8(UDP_DRIVE_MAGIC, buf[0]);
+  TEST_ASSERT_EQUAL_HEX8(0xEF, buf[4]);   // little-endian seq
+  TEST_ASSERT_EQUAL_HEX8(0xBE, buf[5]);
+
+  UdpDrivePacket out;
+  TEST_ASSERT_TRUE(decodeUdpDrivePacket(buf, sizeof(buf), out));
+  TEST_ASSERT_EQUAL_INT(-100, out.x);
+  TEST_ASSERT_EQUAL_INT(42, out.y);
+  TEST_ASSERT_EQUAL_UINT8(75, out.t);
+  TEST_ASSERT_EQUAL_HEX16(0xBEEF, out.seq);
+  TEST_ASSERT_EQUAL_HEX32(0x12345678, out.clientMs);
+}
+
+void test_decode_rejects_bad_length_magic_and_crc(void) {
+  UdpDrivePacket pkt;
+  pkt.x = 10;
+  uint8_t buf[UDP_DRIVE_PACKET_SIZE + 1];
+  encodeUdpDrivePacket(pkt, buf);
+
+  UdpDrivePacket out;
+  TEST_ASSERT_FALSE(decodeUdpDrivePacket(buf, UDP_DRIVE_PACKET_SIZE - 1, out));
+  TEST_ASSERT_FALSE(decodeUdpDrivePacket(buf, UDP_DRIVE_PACKET_SIZE + 1, out));
+
+  buf[1] ^= 0x01;   // payload bit flip
+  TEST_ASSERT_FALSE(decodeUdpDrivePacket(buf, UDP_DRIVE_PACKET_SIZE, out));
+  buf[1] ^= 0x01;
+
+  buf[11] ^= 0x80;  // corrupted CRC
+  TEST_ASSERT_FALSE(decodeUdpDrivePacket(buf, UDP_DRIVE_PACKET_SIZE, out));
+  buf[11] ^= 0x80;
+
+  buf[0] = 0x00;    // wrong magic
+  TEST_ASSERT_FALSE(decodeUdpDrivePacket(buf, UDP_DRIVE_PACKET_SIZE, out));
+}
+
+void test_sequence_drops_stale_and_wraps(void) {
+  UdpSequenceFilter f;
+  TEST_ASSERT_TRUE(f.accept(100, 0, 1000));    // first packet syncs
+  TEST_ASSERT_TRUE(f.accept(101, 50, 1000));
+  TEST_ASSERT_FALSE(f.accept(101, 60, 1000));  // duplicate
+  TEST_ASSERT_FALSE(f.accept(99, 70, 1000));   // reordered, older
+  TEST_ASSERT_TRUE(f.accept(105, 80, 1000));   // gaps are fine
+
+  UdpSequenceFilter w;
+  TEST_ASSERT_TRUE(w.accept(65534, 0, 1000));
+  TEST_ASSERT_TRUE(w.accept(65535, 10, 1000));
+  TEST_ASSERT_TRUE(w.accept(0, 20, 1000));     // 65535 -> 0 is newer
+  TEST_ASSERT_TRUE(w.accept(1, 30, 1000));
+  TEST_ASSERT_FALSE(w.accept(65535, 40, 1000));
+}
+
+void test_sequence_resyncs_after_window(void) {
+  UdpSequenceFilter f;
+  TEST_ASSERT_TRUE(f.accept(5000, 0, 500));
+  TEST_ASSERT_FALSE(f.accept(3, 500, 500));    // still inside the window
+  TEST_ASSERT_TRUE(f.accept(3, 1001, 500));    // restarted sender taken again
+  TEST_ASSERT_TRUE(f.accept(4, 1010, 500));
+
+  // The window is read per call, so a changed timeout applies immediately
+  TEST_ASSERT_FALSE(f.accept(1, 1200, 500));
+  TEST_ASSERT_TRUE(f.accept(1, 1200, 100));
+
+  f.reset();
+  TEST_ASSERT_TRUE(f.accept(0, 1201, 500));
+}
+
+int main(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_crc_check_value);
+  RUN_TEST(test_packet_round_trip);
+  RUN_TEST(test_decode_rejects_bad_length_magic_and_crc);
+  RUN_TEST(test_sequence_drops_stale_and_wraps);
+  RUN_TEST(test_sequence_resyncs_after_window);
+  return UNITY_END();
+}
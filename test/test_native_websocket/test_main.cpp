@@ -0,0 +1,117 @@
+// Host-side tests for the WebSocket handshake and frame parser.
+// Run with: pio test -e native
+
+#include <string.h>
+#include <unity.h>
+
+#include "WebSocket.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// Feeds bytes until the parser reports a frame or an error
+static WebSocketFrameParser::Result feedAll(WebSocketFrameParser& p, const uint8_t* bytes, size_t len) {
+  WebSocketFrameParser::Result r = WebSocketFrameParser::NEED_MORE;
+  for (size_t i = 0; i < len; i++) {
+    r = p.feed(bytes[i]);
+    if (r != WebSocketFrameParser::NEED_MORE) break;
+  }
+  return r;
+}
+
+void test_accept_key_matches_rfc_example(void) {
+  // RFC 6455 section 1.3
+  char accept[WS_ACCEPT_KEY_LEN + 1];
+  webSocketAcceptKey("dGhlIHNhbXBsZSBub25jZQ==", accept);
+  TEST_ASSERT_EQUAL_STRING("s3pPLMBiTxaQ9kYGzzhZRbK+xOo=", accept);
+}
+
+void test_frame_header_lengths(void) {
+  uint8_t h[4];
+  TEST_ASSERT_EQUAL_UINT8(2, webSocketFrameHeader(WS_OP_BINARY, 6, h));
+  TEST_ASSERT_EQUAL_HEX8(0x82, h[0]);
+  TEST_ASSERT_EQUAL_HEX8(6, h[1]);
+
+  TEST_ASSERT_EQUAL_UINT8(4, webSocketFrameHeader(WS_OP_TEXT, 300, h));
+  TEST_ASSERT_EQUAL_HEX8(0x81, h[0]);
+  TEST_ASSERT_EQUAL_HEX8(126, h[1]);
+  TEST_ASSERT_EQUAL_HEX8(0x01, h[2]);
+  TEST_ASSERT_EQUAL_HEX8(0x2C, h[3]);
+}
+
+void test_masked_binary_frame(void) {
+  // Drive command 01 f6 32 64 masked with 37 fa 21 3d
+  const uint8_t mask[4] = { 0x37, 0xFA, 0x21, 0x3D };
+  const uint8_t payload[4] = { 0x01, 0xF6, 0x32, 0x64 };
+  uint8_t frame[2 + 4 + 4] = { 0x82, 0x84, 0x37, 0xFA, 0x21, 0x3D };
+  for (uint8_t i = 0; i < 4; i++) frame[6 + i] = payload[i] ^ mask[i];
+
+  WebSocketFrameParser p;
+  TEST_ASSERT_EQUAL(WebSocketFrameParser::FRAME, feedAll(p, frame, sizeof(frame)));
+  TEST_ASSERT_EQUAL_HEX8(WS_OP_BINARY, p.opcode());
+  TEST_ASSERT_EQUAL_UINT8(4, p.payloadLength());
+  TEST_ASSERT_EQUAL_MEMORY(payload, p.payload(), 4);
+
+  // The parser is ready for the next frame: an empty masked ping
+  const uint8_t ping[] = { 0x89, 0x80, 1, 2, 3, 4 };
+  TEST_ASSERT_EQUAL(WebSocketFrameParser::FRAME, feedAll(p, ping, sizeof(ping)));
+  TEST_ASSERT_EQUAL_HEX8(WS_OP_PING, p.opcode());
+  TEST_ASSERT_EQUAL_UINT8(0, p.payloadLength());
+}
+
+void test_16bit_length_within_limit(void) {
+  // 126 + 2-byte length is accepted as long as it fits MAX_PAYLOAD
+  uint8_t frame[4 + 4 + WebSocketFrameParser::MAX_PAYLOAD] = { 0x82, 0xFE, 0x00, WebSocketFrameParser::MAX_PAYLOAD };
+  WebSocketFrameParser p;
+  TEST_ASSERT_EQUAL(WebSocketFrameParser::FRAME, feedAll(p, frame, sizeof(frame)));
+  TEST_ASSERT_EQUAL_UINT8(WebSocketFrameParser::MAX_PAYLOAD, p.payloadLength());
+}
+
+void test_rejects_unmasked_client_frame(void) {
+  const uint8_t frame[] = { 0x82, 0x02, 0x03, 0x00 };
+  WebSocketFrameParser p;
+  TEST_ASSERT_EQUAL(WebSocketFrameParser::ERROR, feedAll(p, frame, sizeof(frame)));
+}
+
+void test_rejects_fragmented_frames(void) {
+  // FIN clear on the first fragment
+  const uint8_t first[] = { 0x02, 0x81, 0, 0, 0, 0, 0x03 };
+  WebSocketFrameParser p;
+  TEST_ASSERT_EQUAL(WebSocketFrameParser::ERROR, feedAll(p, first, sizeof(first)));
+
+  // A lone continuation frame
+  const uint8_t cont[] = { 0x80, 0x81, 0, 0, 0, 0, 0x03 };
+  WebSocketFrameParser q;
+  TEST_ASSERT_EQUAL(WebSocketFrameParser::ERROR, feedAll(q, cont, sizeof(cont)));
+}
+
+void test_rejects_64bit_length(void) {
+  const uint8_t frame[] = { 0x82, 0xFF, 0, 0, 0, 0, 0, 0, 0, 4 };
+  WebSocketFrameParser p;
+  TEST_ASSERT_EQUAL(WebSocketFrameParser::ERROR, feedAll(p, frame, sizeof(frame)));
+}
+
+void test_rejects_payload_over_limit(void) {
+  const uint8_t small[] = { 0x82, (uint8_t)(0x80 | (WebSocketFrameParser::MAX_PAYLOAD + 1)) };
+  WebSocketFrameParser p;
+  TEST_ASSERT_EQUAL(WebSocketFrameParser::ERROR, feedAll(p, small, sizeof(small)));
+
+  const uint8_t extended[] = { 0x82, 0xFE, 0x01, 0x00 };   // 256 bytes
+  WebSocketFrameParser q;
+  TEST_ASSERT_EQUAL(WebSocketFrameParser::ERROR, feedAll(q, extended, sizeof(extended)));
+}
+
+int main(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_accept_key_matches_rfc_example);
+  RUN_TEST(test_frame_header_lengths);
+  RUN_TEST(test_masked_binary_frame);
+  RUN_TEST(test_16bit_length_within_limit);
+  RUN_TEST(test_rejects_unmasked_client_frame);
+  RUN_TEST(test_rejects_fragmented_frames);
+  RUN_TEST(test_rejects_64bit_length);
+  RUN_TEST(test_rejects_payload_over_limit);
+  return UNITY_END();
+}
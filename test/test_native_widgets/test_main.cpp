@@ -0,0 +1,344 @@
+// Host-side tests for the event queue, the widget registry and its deferred
+// callbacks, and a check that request handling allocates nothing once set up.
+// Run with: pio test -e native
+
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unity.h>
+
+#include "EventQueue.h"
+#include "HttpRequestParser.h"
+#include "ResponseWriter.h"
+#include "WidgetRegistry.h"
+
+// Every C++ heap allocation in this test binary goes through here
+static unsigned long g_allocations = 0;
+
+void* operator new(size_t n) {
+  g_allocations++;
+  void* p = malloc(n ? n : 1);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+void* operator new[](size_t n) { return operator new(n); }
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+
+struct Recorder {
+  int events = 0;
+  WidgetEvent last = { WIDGET_MESSAGE, 0, "", 0, "" };
+  char text[64] = "";
+};
+
+static void recordEvent(const WidgetEvent& e, void* ctx) {
+  Recorder* r = static_cast<Recorder*>(ctx);
+  r->events++;
+  r->last = e;
+  strncpy(r->text, e.text, sizeof(r->text) - 1);
+}
+
+static int g_presses = 0;
+static int g_sliderCalls = 0;
+static int g_sliderValue = 0;
+static void onPress() { g_presses++; }
+static void onSlider(int v) { g_sliderCalls++; g_sliderValue = v; }
+
+void setUp(void) {
+  g_presses = 0;
+  g_sliderCalls = 0;
+  g_sliderValue = 0;
+}
+void tearDown(void) {}
+
+static size_t discard(void* ctx, const uint8_t* data, size_t len) {
+  (void)data;
+  *static_cast<size_t*>(ctx) += len;
+  return len;
+}
+
+static size_t capture(void* ctx, const uint8_t* data, size_t len) {
+  char* out = static_cast<char*>(ctx);
+  const size_t used = strlen(out);
+  memcpy(out + used, data, len);
+  out[used + len] = '\0';
+  return len;
+}
+
+void test_event_queue_fifo_and_full(void) {
+  SpscQueue<int, 4> q;
+  int v = 0;
+  TEST_ASSERT_TRUE(q.empty());
+  TEST_ASSERT_FALSE(q.pop(v));
+
+  for (int i = 1; i <= 4; i++) TEST_ASSERT_TRUE(q.push(i));
+  TEST_ASSERT_FALSE(q.push(5));   // full: rejected, nothing overwritten
+  TEST_ASSERT_EQUAL_UINT8(4, q.size());
+
+  TEST_ASSERT_TRUE(q.pop(v));
+  TEST_ASSERT_EQUAL_INT(1, v);
+  TEST_ASSERT_TRUE(q.push(5));
+
+  for (int want = 2; want <= 5; want++) {
+    TEST_ASSERT_TRUE(q.pop(v));
+    TEST_ASSERT_EQUAL_INT(want, v);
+  }
+  TEST_ASSERT_TRUE(q.empty());
+}
+
+void test_event_queue_wraps_indices(void) {
+  // 300 round trips run the 8-bit indices past 255
+  SpscQueue<uint16_t, 8> q;
+  uint16_t v = 0;
+  for (uint16_t i = 0; i < 300; i++) {
+    TEST_ASSERT_TRUE(q.push(i));
+    TEST_ASSERT_TRUE(q.push((uint16_t)(i + 1000)));
+    TEST_ASSERT_TRUE(q.pop(v));
+    TEST_ASSERT_EQUAL_UINT16(i, v);
+    TEST_ASSERT_TRUE(q.pop(v));
+    TEST_ASSERT_EQUAL_UINT16(i + 1000, v);
+  }
+  TEST_ASSERT_EQUAL_UINT8(0, q.size());
+}
+
+void test_capacity_and_labels_are_not_copied(void) {
+  Widgets<2, 1> w;
+  static const char label[] = "Arm";
+  TEST_ASSERT_TRUE(w.addButton(label, onPress));
+  TEST_ASSERT_TRUE(w.addButton("Claw", onPress));
+  TEST_ASSERT_FALSE(w.addButton("Extra", onPress));
+  TEST_ASSERT_EQUAL_PTR(label, w.button(0).label);
+
+  TEST_ASSERT_TRUE(w.addSlider("Speed", onSlider, 100, 0, 150, 0));   // reversed range, bad step
+  TEST_ASSERT_FALSE(w.addSlider("Extra", onSlider, 0, 10, 0, 1));
+  TEST_ASSERT_EQUAL_INT(0, w.slider(0).minVal);
+  TEST_ASSERT_EQUAL_INT(100, w.slider(0).value);
+  TEST_ASSERT_EQUAL_INT(1, w.slider(0).step);
+
+  TEST_ASSERT_EQUAL(WIDGET_BAD_ID, w.press(2));
+  TEST_ASSERT_EQUAL(WIDGET_BAD_ID, w.setSlider(-1, 0));
+}
+
+void test_callbacks_run_on_dispatch_only(void) {
+  Widgets<2, 2> w;
+  Recorder rec;
+  w.addButton("Go", onPress);
+
+  TEST_ASSERT_EQUAL(WIDGET_OK, w.press(0));
+  TEST_ASSERT_EQUAL(WIDGET_OK, w.message("hello world"));
+  TEST_ASSERT_EQUAL_INT(0, g_presses);
+
+  w.dispatch(recordEvent, &rec);
+  TEST_ASSERT_EQUAL_INT(1, g_presses);
+  TEST_ASSERT_EQUAL_INT(2, rec.events);
+  TEST_ASSERT_EQUAL(WIDGET_MESSAGE, rec.last.type);
+  TEST_ASSERT_EQUAL_STRING("hello world", rec.text);
+
+  w.dispatch(recordEvent, &rec);
+  TEST_ASSERT_EQUAL_INT(2, rec.events);
+}
+
+void test_slider_drags_conflate_to_latest(void) {
+  Widgets<1, 2> w;
+  Recorder rec;
+  w.addSlider("Angle", onSlider, 0, 180, 90, 1);
+  w.addSlider("Other", onSlider, 0, 10, 0, 1);
+
+  for (int v = 0; v <= 200; v += 5) TEST_ASSERT_EQUAL(WIDGET_OK, w.setSlider(0, v));
+  TEST_ASSERT_EQUAL_INT(180, w.slider(0).value);   // stored at once, clamped
+
+  w.dispatch(recordEvent, &rec);
+  TEST_ASSERT_EQUAL_INT(1, g_sliderCalls);
+  TEST_ASSERT_EQUAL_INT(180, g_sliderValue);
+  TEST_ASSERT_EQUAL_INT(1, rec.events);
+  TEST_ASSERT_EQUAL(WIDGET_SLIDER, rec.last.type);
+  TEST_ASSERT_EQUAL_INT(180, rec.last.value);
+  TEST_ASSERT_EQUAL_STRING("Angle", rec.last.label);
+
+  // Queued again after dispatch
+  w.setSlider(0, 10);
+  w.dispatch(recordEvent, &rec);
+  TEST_ASSERT_EQUAL_INT(2, g_sliderCalls);
+  TEST_ASSERT_EQUAL_INT(10, g_sliderValue);
+}
+
+void test_cleared_widgets_drop_queued_events(void) {
+  Widgets<1, 1> w;
+  Recorder rec;
+  w.addButton("Old", onPress);
+  w.addSlider("Old", onSlider, 0, 100, 0, 1);
+  TEST_ASSERT_EQUAL(WIDGET_OK, w.press(0));
+  TEST_ASSERT_EQUAL(WIDGET_OK, w.setSlider(0, 40));
+
+  // Re-registered before dispatch: the new widgets get no stale events
+  w.clearButtons();
+  w.clearSliders();
+  w.addButton("New", onPress);
+  w.addSlider("New", onSlider, 0, 100, 0, 1);
+  w.dispatch(recordEvent, &rec);
+  TEST_ASSERT_EQUAL_INT(0, rec.events);
+  TEST_ASSERT_EQUAL_INT(0, g_presses);
+  TEST_ASSERT_EQUAL_INT(0, g_sliderCalls);
+
+  // And the new slider is not stuck as already queued
+  TEST_ASSERT_EQUAL(WIDGET_OK, w.setSlider(0, 7));
+  w.dispatch(recordEvent, &rec);
+  TEST_ASSERT_EQUAL_INT(1, g_sliderCalls);
+  TEST_ASSERT_EQUAL_INT(7, g_sliderValue);
+  TEST_ASSERT_EQUAL_STRING("New", rec.last.label);
+}
+
+void test_message_text_shares_one_ring(void) {
+  Widgets<1, 1> w;
+  Recorder rec;
+  char longText[80];
+  memset(longText, 'x', sizeof(longText) - 1);
+  longText[sizeof(longText) - 1] = '\0';
+
+  // Cut at EVENT_TEXT_MAX; two fit the pool, the third waits for dispatch
+  TEST_ASSERT_EQUAL(WIDGET_OK, w.message(longText));
+  TEST_ASSERT_EQUAL(WIDGET_OK, w.message(longText));
+  TEST_ASSERT_EQUAL(WIDGET_BUSY, w.message(longText));
+  TEST_ASSERT_EQUAL(WIDGET_OK, w.message("short"));
+  w.dispatch(recordEvent, &rec);
+  TEST_ASSERT_EQUAL_INT(3, rec.events);
+  TEST_ASSERT_EQUAL_STRING("short", rec.text);
+
+  // Text that wraps around the end of the ring comes out whole
+  char expect[16];
+  for (int i = 0; i < 100; i++) {
+    snprintf(expect, sizeof(expect), "msg %d", i);
+    TEST_ASSERT_EQUAL(WIDGET_OK, w.message(expect));
+    TEST_ASSERT_EQUAL(WIDGET_OK, w.message(""));
+    w.dispatch(recordEvent, &rec);
+    TEST_ASSERT_EQUAL_STRING("", rec.text);
+    TEST_ASSERT_EQUAL(WIDGET_OK, w.message(expect));
+    memset(rec.text, 0, sizeof(rec.text));
+    w.dispatch(recordEvent, &rec);
+    TEST_ASSERT_EQUAL_STRING(expect, rec.text);
+  }
+}
+
+void test_full_queue_is_busy_but_sliders_get_through(void) {
+  Widgets<1, 2> w;
+  w.addButton("Go", onPress);
+  w.addSlider("A", onSlider, 0, 100, 0, 1);
+  w.addSlider("B", onSlider, 0, 100, 0, 1);
+
+  int accepted = 0;
+  while (w.press(0) == WIDGET_OK) accepted++;
+  TEST_ASSERT_EQUAL_INT(WidgetRegistry::EVENT_QUEUE_SIZE - 2, accepted);
+  TEST_ASSERT_EQUAL(WIDGET_BUSY, w.message("late"));
+
+  TEST_ASSERT_EQUAL(WIDGET_OK, w.setSlider(0, 1));
+  TEST_ASSERT_EQUAL(WIDGET_OK, w.setSlider(1, 2));
+
+  w.dispatch(nullptr, nullptr);
+  TEST_ASSERT_EQUAL_INT(accepted, g_presses);
+  TEST_ASSERT_EQUAL_INT(2, g_sliderCalls);
+}
+
+void test_manifest_json_and_hash(void) {
+  Widgets<2, 1> w;
+  w.addButton("Say \"hi\" <b>", onPress);
+  w.addSlider("S", onSlider, -5, 5, 1, 1);
+
+  char out[256] = "";
+  uint8_t buf[64];
+  ResponseWriter rw(buf, sizeof(buf), capture, out);
+  w.writeButtonsJson(rw);
+  rw.print('|');
+  w.writeSlidersJson(rw);
+  rw.flush();
+  TEST_ASSERT_EQUAL_STRING(
+      "{\"id\":0,\"label\":\"Say \\\"hi\\\" \\u003cb>\"}|"
+      "{\"id\":0,\"label\":\"S\",\"min\":-5,\"max\":5,\"step\":1,\"value\":1}", out);
+
+  const uint32_t h = w.hash();
+  TEST_ASSERT_EQUAL_UINT32(h, w.hash());
+  w.setSlider(0, 2);
+  TEST_ASSERT_NOT_EQUAL(h, w.hash());
+}
+
+// One request through the same steps as Controller: parse, route, queue,
+// reply; then dispatch and render the page data
+static void handle(HttpRequestParser& parser, WidgetRegistry& w, const char* raw, size_t& sent) {
+  parser.reset();
+  for (const char* c = raw; *c; c++) parser.feed(*c);
+  const HttpRequest& req = parser.request();
+
+  WidgetStatus status = WIDGET_BAD_ID;
+  int id = -1, v = 0;
+  if (req.isGet("/btn") && req.paramInt("id", id)) status = w.press(id);
+  else if (req.isGet("/sld") && req.paramInt("id", id) && req.paramInt("v", v)) status = w.setSlider(id, v);
+  else if (req.isGet("/control") && req.param("msg")) status = w.message(req.param("msg"));
+
+  uint8_t buf[128];
+  ResponseWriter rw(buf, sizeof(buf), discard, &sent);
+  rw.status(200, "OK");
+  rw.header("Content-Type", "text/plain; charset=utf-8");
+  rw.endHeaders();
+  rw.print(status == WIDGET_OK ? "OK" : "Bad id");
+  rw.finish();
+}
+
+void test_steady_state_requests_do_not_allocate(void) {
+  static Widgets<8, 8> w;
+  static HttpRequestParser parser;
+  Recorder rec;
+  size_t sent = 0;
+
+  w.addButton("Press ME", onPress);
+  w.addSlider("Servo Angle", onSlider, 0, 180, 90, 1);
+
+  const unsigned long before = g_allocations;
+  for (int i = 0; i < 200; i++) {
+    handle(parser, w, "GET /btn?id=0 HTTP/1.1\r\nHost: 10.0.0.2\r\n\r\n", sent);
+    handle(parser, w, "GET /sld?id=0&v=120 HTTP/1.1\r\nHost: 10.0.0.2\r\n\r\n", sent);
+    handle(parser, w, "GET /control?msg=hello+world HTTP/1.1\r\n\r\n", sent);
+    w.dispatch(recordEvent, &rec);
+
+    uint8_t buf[128];
+    ResponseWriter rw(buf, sizeof(buf), discard, &sent);
+    w.writeButtonsJson(rw);
+    w.writeSlidersJson(rw);
+    rw.finish();
+    w.hash();
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(0, g_allocations - before);
+  TEST_ASSERT_EQUAL_INT(200, g_presses);
+  TEST_ASSERT_EQUAL_INT(200, g_sliderCalls);
+  TEST_ASSERT_EQUAL_INT(600, rec.events);
+  TEST_ASSERT_EQUAL_STRING("hello world", rec.text);
+  TEST_ASSERT_TRUE(sent > 0);
+}
+
+void test_allocation_counter_sees_new(void) {
+  // Guards the test above against a counter that never counts
+  const unsigned long before = g_allocations;
+  int* p = new int(1);
+  delete p;
+  TEST_ASSERT_EQUAL_UINT32(1, g_allocations - before);
+}
+
+int main(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_event_queue_fifo_and_full);
+  RUN_TEST(test_event_queue_wraps_indices);
+  RUN_TEST(test_capacity_and_labels_are_not_copied);
+  RUN_TEST(test_callbacks_run_on_dispatch_only);
+  RUN_TEST(test_slider_drags_conflate_to_latest);
+  RUN_TEST(test_cleared_widgets_drop_queued_events);
+  RUN_TEST(test_message_text_shares_one_ring);
+  RUN_TEST(test_full_queue_is_busy_but_sliders_get_through);
+  RUN_TEST(test_manifest_json_and_hash);
+  RUN_TEST(test_steady_state_requests_do_not_allocate);
+  RUN_TEST(test_allocation_counter_sees_new);
+  return UNITY_END();
+}